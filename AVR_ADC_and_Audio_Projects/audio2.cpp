@@ -2,22 +2,52 @@
 #include <avr/interrupt.h>
 // #include <stdio.h> // Not strictly needed for this C++ conversion unless printf is used
 #include "song.h"
+#include "DDS_Tone.h"
+#include "Note_Table.h"
+#include "No_Float.h"
 
 #define F_CPU 4000000UL
 
-#define TCA_PER(x) ((uint16_t)(F_CPU / ((x) * 64) - 1))
 #define DEBOUNCE_TIME 50
 
 #define BUTTON_PINS (PIN2_bm | PIN3_bm | PIN4_bm | PIN5_bm | PIN6_bm | PIN7_bm)
 
 volatile uint8_t debounce_flag = 0;
+volatile uint8_t debounce_pending = 0;
 volatile uint16_t millis = 0;
-volatile uint8_t current_note = mute;
 
-void init_dac() {
-    VREF.DAC0REF = VREF_REFSEL_2V048_gc;
-    DAC0.CTRLA = DAC_OUTEN_bm | DAC_ENABLE_bm;
-    DAC0.DATA = sine_table[0] << 6;  // Start with no sound (mute)
+// Piano keys on port A (key 0 ... 5) and their tuning words, the key on PB0 (note a) is KEY_COUNT (last note of key_notes)
+#define KEY_COUNT 6
+static const uint8_t key_pins[KEY_COUNT] = {PIN2_bm, PIN3_bm, PIN4_bm, PIN5_bm, PIN6_bm, PIN7_bm};
+typedef note_table<c, d, e, f, g, h, a> key_notes;
+static_assert(key_notes::count == KEY_COUNT + 1, "one note per key, the last one for PB0");
+volatile uint8_t keys_down = 0;     // Port A keys as last seen
+volatile uint8_t key_b_down = 0;    // PB0 as last seen
+
+// Compare all keys with their last state: one voice per pressed key, a release ends only its own note
+void update_keys() {
+    uint8_t pressed = PORTA.IN & BUTTON_PINS;
+    uint8_t changed = pressed ^ keys_down;
+    keys_down = pressed;
+    for (uint8_t key = 0; key < KEY_COUNT; key++) {
+        if (!(changed & key_pins[key]))
+            continue;
+        if (pressed & key_pins[key]) {
+            dds_noteOn(key, key_notes::tuning[key]);
+        } else {
+            dds_noteOff(key);
+        }
+    }
+
+    uint8_t pressed_b = PORTB.IN & PIN0_bm;
+    if (pressed_b != key_b_down) {
+        key_b_down = pressed_b;
+        if (pressed_b) {
+            dds_noteOn(KEY_COUNT, key_notes::tuning[KEY_COUNT]);
+        } else {
+            dds_noteOff(KEY_COUNT);
+        }
+    }
 }
 
 void init_debouncer() {
@@ -28,83 +58,51 @@ void init_debouncer() {
 
 ISR(TCA1_OVF_vect) {
     millis++;
+    if (debounce_pending) {     // Edges during the lock: read the settled keys now
+        debounce_pending = 0;
+        update_keys();
+    }
     debounce_flag = 0;
     TCA1.SINGLE.INTFLAGS = TCA_SINGLE_OVF_bm;
 }
 
-//ISR for buttons at Port B
-ISR(PORTB_PORT_vect) {
+// Key edge: evaluate at most once per millisecond, later edges are handled by the next tick
+void key_edge() {
     if (!debounce_flag) {
         debounce_flag = 1;
-        if (PORTB.IN & PIN0_bm) {   
-                TCA0.SINGLE.PER = TCA_PER(a);
-                TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-            } else {
-            current_note = mute;
-            TCA0.SINGLE.CTRLA &= ~TCA_SINGLE_ENABLE_bm;
-        }
-        PORTB.INTFLAGS = PIN0_bm;
+        update_keys();
+    } else {
+        debounce_pending = 1;
     }
 }
 
-//ISR for buttons at Port A
-ISR(PORTA_PORT_vect) {
-    if (!debounce_flag) {
-        debounce_flag = 1;
-        if (PORTA.IN & PIN2_bm) {
-                TCA0.SINGLE.PER = TCA_PER(c);
-                TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-            } else if (PORTA.IN & PIN3_bm) {
-                TCA0.SINGLE.PER = TCA_PER(d);
-                TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-            } else if (PORTA.IN & PIN4_bm) {
-                TCA0.SINGLE.PER = TCA_PER(e);
-                TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-            } else if (PORTA.IN & PIN5_bm) {
-                TCA0.SINGLE.PER = TCA_PER(f);
-                TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-            } else if (PORTA.IN & PIN6_bm) {
-                TCA0.SINGLE.PER = TCA_PER(g);
-                TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-            } else if (PORTA.IN & PIN7_bm) {
-                TCA0.SINGLE.PER = TCA_PER(h);
-                TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-            }
-            } else {
-            current_note = mute;
-            TCA0.SINGLE.CTRLA &= ~TCA_SINGLE_ENABLE_bm;
-        }
-        PORTA.INTFLAGS = BUTTON_PINS;
-    }
+//ISR for buttons at Port B
+ISR(PORTB_PORT_vect) {
+    PORTB.INTFLAGS = PIN0_bm;
+    key_edge();
 }
 
-//ISR for timer after an Overflow of the counter has occurred
-ISR(TCA0_OVF_vect) {
-    static uint8_t current = 0;
-    if (current >= 64) current = 0;
-    DAC0.DATA = sine_table[current++] << 6;
-    TCA0.SINGLE.INTFLAGS = TCA_SINGLE_OVF_bm;
+//ISR for buttons at Port A
+ISR(PORTA_PORT_vect) {
+    PORTA.INTFLAGS = BUTTON_PINS;
+    key_edge();
 }
 
 int main() { // Changed from main(void) to main()
-    // Configuration of buttons as input (piano keys)
+    // Configuration of buttons as input (piano keys, both edges: press and release)
     PORTA.DIRCLR = BUTTON_PINS;
     PORTB.DIRCLR = PIN0_bm;
-    PORTA.PIN2CTRL = PORT_ISC_RISING_gc;
-    PORTA.PIN3CTRL = PORT_ISC_RISING_gc;
-    PORTA.PIN4CTRL = PORT_ISC_RISING_gc;
-    PORTA.PIN5CTRL = PORT_ISC_RISING_gc;
-    PORTA.PIN6CTRL = PORT_ISC_RISING_gc;
-    PORTA.PIN7CTRL = PORT_ISC_RISING_gc;
-    PORTB.PIN0CTRL = PORT_ISC_RISING_gc;
-
-    init_dac();
-    init_debouncer();
+    PORTA.PIN2CTRL = PORT_ISC_BOTHEDGES_gc;
+    PORTA.PIN3CTRL = PORT_ISC_BOTHEDGES_gc;
+    PORTA.PIN4CTRL = PORT_ISC_BOTHEDGES_gc;
+    PORTA.PIN5CTRL = PORT_ISC_BOTHEDGES_gc;
+    PORTA.PIN6CTRL = PORT_ISC_BOTHEDGES_gc;
+    PORTA.PIN7CTRL = PORT_ISC_BOTHEDGES_gc;
+    PORTB.PIN0CTRL = PORT_ISC_BOTHEDGES_gc;
 
-    // Timer/Counter TCA0 Configuration
-    TCA0.SINGLE.INTCTRL = TCA_SINGLE_OVF_bm;
-    TCA0.SINGLE.CTRLA = TCA_SINGLE_CLKSEL_DIV1_gc;
-    TCA0.SINGLE.PER = TCA_PER(mute);
+    dds_init(); // DAC and sample clock (TCA0 at a fixed rate), all voices silent
+    dds_setEnvelope(5, 600, 140, 250); // Plucked: 5ms attack, decay to ~55%, 250ms release
+    init_debouncer();
 
     sei();
 
@@ -1,128 +1,96 @@
 #include <avr/io.h>
+#include <avr/interrupt.h>
 #include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
 #include "I2C_LCD.h"
+#include "AVR128DB48_ADC.h"
+#include "ADC_Scale.h"
 
 // Buffer fr Strings
-char buffer[16];  
-char buffer1[16]; 
+char buffer[ADC_SCALE_TEXT_SIZE];  
+char buffer1[ADC_SCALE_TEXT_SIZE]; 
 
-// Vorherige Werte zur stabilen Anzeige
-float prev_voltage = -1.0f; // Use .0f for float literals
-float prev_percent = -1.0f;
+adc_channel_scale voltage_scale; ///< 10mV-Einheiten: 330 = 3.30V (VREF = VDD)
+adc_channel_scale percent_scale; ///< 0.01%-Einheiten: 10000 = 100.00%
+
+#define BAR_COLUMN 8 ///< Erste Spalte des Balkendiagramms
+#define ADC_RESOLUTION 14 ///< Mittelwert aus 16 Messungen: 14 Bit, Rauschen auf 1/4 (siehe AVR128DB48_ADC.h)
+#define ADC_DEADBAND 8    ///< Aenderungen bis 8 / 16384 (2 LSB bei 12 Bit) werden ignoriert
 
 /**
  * @brief Initialisiert den ADC fr PF3.
  * 
- * Konfiguriert den ADC mit VDD als Referenzspannung, 12-Bit-Auflsung und dem Eingangskanal PF3 (AIN19).
+ * Konfiguriert den ADC mit VDD als Referenzspannung und dem Eingangskanal PF3 (AIN19).
+ * Der ADC addiert 16 Messungen in Hardware, das Ergebnis hat ADC_RESOLUTION Bit.
+ * Er wandelt fortlaufend, der Fensterkomparator meldet nur Aenderungen groesser als ADC_DEADBAND.
  */
 void init_ADC(); // Removed void from parameter list for C++
 
 /**
- * @brief Liest einen Wert vom ADC.
+ * @brief Wartet auf einen geaenderten Wert vom ADC.
  * 
- * Startet eine ADC-Konvertierung und wartet, bis das Ergebnis verfgbar ist.
+ * Schlaeft (Idle), bis der Fensterkomparator eine Aenderung meldet. Rauschen innerhalb
+ * des Fensters weckt die CPU nicht.
  * 
- * @return 12-Bit-Ergebnis der ADC-Konvertierung.
+ * @return Mittelwert von 16 Messungen mit ADC_RESOLUTION Bit (0 ... 16383).
  */
 uint16_t read_ADC(); // Removed void from parameter list for C++
 
 /**
  * @brief Aktualisiert das LCD-Display nur, wenn sich Werte gendert haben.
  * 
- * Vergleicht die bergebenen Werte mit den vorherigen und aktualisiert das LCD
- * nur, wenn Unterschiede festgestellt werden.
- * 
- * @param voltage Aktuelle Spannung in Volt.
- * @param percent Aktueller Prozentsatz.
- */
-void update_lcd_if_changed(float voltage, float percent);
-
-/**
- * @brief Konvertiert einen Float-Wert in eine ASCII-Zeichenkette.
- * 
- * Wandelt einen Fliekommawert in eine Zeichenkette mit der angegebenen Anzahl an Dezimalstellen um
- * und fgt eine Einheit am Ende hinzu.
+ * Schreibt die Werte und ein Balkendiagramm in den Bildschirmpuffer; lcd_flush()
+ * sendet nur die Zeichen, die sich geaendert haben. Die Teilbloecke des Balkens
+ * bleiben im CGRAM und werden nur beim ersten Gebrauch uebertragen.
  * 
- * @param value Der zu konvertierende Wert.
- * @param buf Der Zielpuffer fr die Zeichenkette.
- * @param decimal_places Anzahl der Nachkommastellen.
- * @param unit Einheit, die an den Wert angehngt wird.
+ * @param voltage Aktuelle Spannung in 10mV (siehe voltage_scale).
+ * @param percent Aktueller Prozentsatz in 0.01% (siehe percent_scale).
+ * @param adcValue ADC-Ergebnis fuer das Balkendiagramm.
  */
-void float_to_ascii(float value, char *buf, int decimal_places, char unit);
+void update_lcd_if_changed(int32_t voltage, int32_t percent, uint16_t adcValue);
 
 void init_ADC() {
     PORTF.DIRCLR = PIN3_bm;                    
-    VREF.ADC0REF = VREF_REFSEL_VDD_gc;         
-    ADC0.MUXPOS = ADC_MUXPOS_AIN19_gc;         
-    ADC0.CTRLB = ADC_RESSEL_12BIT_gc;          
-    ADC0.CTRLA = ADC_ENABLE_bm;                
-    ADC0.CTRLC = ADC_PRESC_DIV4_gc;            
+    adc_init();                                
+    adc_setOversampling(ADC_SAMPNUM_ACC16_gc, ADC_RESOLUTION);
+    adc_startNotify(ADC_MUXPOS_AIN19_gc, ADC_DEADBAND);
+    sei();                                     
 }
 
 uint16_t read_ADC() {
-    ADC0.COMMAND = ADC_STCONV_bm;              
-    while (!(ADC0.INTFLAGS & ADC_RESRDY_bm));  
-    ADC0.INTFLAGS = ADC_RESRDY_bm;             
-    return ADC0.RES;                           
+    return adc_waitChange();                   
 }
 
-void float_to_ascii(float value, char *buf, int decimal_places, char unit) {
-    int whole_part = static_cast<int>(value); // C++ style cast                       
-    int fractional_part = static_cast<int>((value - whole_part) * 10 * decimal_places); // C++ style cast
-
-    int i = 0;
-    if (whole_part == 0) {
-        buf[i++] = '0';
-    } else {
-        char temp[8];
-        int j = 0;
-        while (whole_part > 0) {
-            temp[j++] = static_cast<char>((whole_part % 10) + '0'); // C++ style cast
-            whole_part /= 10;
-        }
-        while (j > 0) {
-            buf[i++] = temp[--j];
-        }
-    }
+void update_lcd_if_changed(int32_t voltage, int32_t percent, uint16_t adcValue) {
+    lcd_bufferClear();
 
-    buf[i++] = '.';
-    for (int d = 0; d < decimal_places; d++) {
-        buf[i++] = static_cast<char>((fractional_part % 10) + '0'); // C++ style cast
-        fractional_part /= 10;
-    }
+    adc_scale_format(&voltage_scale, voltage, buffer); 
+    lcd_bufferPutString(0, 0, buffer); 
 
-    buf[i++] = unit;
-    buf[i] = '\0';
-}
+    adc_scale_format(&percent_scale, percent, buffer1); 
+    lcd_bufferPutString(0, 1, buffer1); 
 
-void update_lcd_if_changed(float voltage, float percent) {
-    if (voltage != prev_voltage) {
-        lcd_moveCursor(0, 0); 
-        float_to_ascii(voltage, buffer, 2, 'V'); 
-        lcd_putString(buffer); 
-        prev_voltage = voltage; 
-    }
+    // Balken ueber beide Zeilen: 2 x 8 Zellen zu je 5 Spalten
+    uint16_t half = (1U << ADC_RESOLUTION) / 2;
+    lcd_bufferPutBar(BAR_COLUMN, 0, LCD_COLUMNS - BAR_COLUMN, adcValue, half);
+    lcd_bufferPutBar(BAR_COLUMN, 1, LCD_COLUMNS - BAR_COLUMN, (adcValue > half) ? static_cast<uint16_t>(adcValue - half) : 0, half);
 
-    if (percent != prev_percent) {
-        lcd_moveCursor(0, 1); 
-        float_to_ascii(percent, buffer1, 2, '%'); 
-        lcd_putString(buffer1); 
-        prev_percent = percent; 
-    }
+    lcd_flush();
 }
 
 int main() { // Changed from main(void) to int main()
     lcd_init();
     lcd_enable(true);
     init_ADC();
+    adc_scale_setup(&voltage_scale, 330, adc_resolution(), 2, 'V');    // Festkomma statt Soft-Float
+    adc_scale_setup(&percent_scale, 10000, adc_resolution(), 2, '%');
 
     while (true) { // Use true instead of 1 for C++
-        uint16_t adcValue = read_ADC(); 
+        uint16_t adcValue = read_ADC(); // Kehrt nur zurueck, wenn sich der Wert bewegt hat
 
-        float percent = (adcValue * 100.0f) / 4095.0f; // Use .0f for float literals
-        float voltage = (adcValue * 3.3f) / 4095.0f; // Use .0f for float literals
+        int32_t percent = adc_scale_apply(&percent_scale, adcValue);
+        int32_t voltage = adc_scale_apply(&voltage_scale, adcValue);
 
-        update_lcd_if_changed(voltage, percent);
+        update_lcd_if_changed(voltage, percent, adcValue);
     }
     return 0; // Added return 0 for int main()
 }
\ No newline at end of file
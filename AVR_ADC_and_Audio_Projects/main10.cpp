@@ -0,0 +1,67 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
+#define F_CPU 4000000UL
+#include <util/delay.h>
+#include "I2C_LCD.h"
+#include "DDS_Tone.h"
+#include "Text_Format.h"
+#include "No_Float.h"
+
+/**
+ * @file main10.cpp
+ * @brief Rechenzeit des DDS-Abtastinterrupts je Anzahl klingender Stimmen.
+ *
+ * Ein Akkord waechst Ton fuer Ton von Stille bis DDS_VOICES Stimmen, danach kommt ein Ton
+ * mehr als Stimmen vorhanden sind (der aelteste Ton wird verdraengt). Je Stufe zeigt das LCD:
+ * - Zeile 1: Anzahl klingender Stimmen und die groessten Kosten einer Abtastperiode im
+ *   Verhaeltnis zum Budget F_CPU / DDS_SAMPLE_RATE (500 Zyklen bei 4MHz / 8kHz). Gezaehlt wird
+ *   vom Timerueberlauf bis zum Ende des Interrupts, also mit Latenz, Ein- und Austritt und dem
+ *   Huellkurvenschritt (hoechstens einer pro Abtastwert),
+ * - Zeile 2: Reserve bis zum Budget (Rest)
+ *   und die Anzahl begrenzter (saettigender) Abtastwerte in der Messsekunde.
+ */
+
+#define CYCLE_BUDGET (F_CPU / DDS_SAMPLE_RATE) ///< Zyklen pro Abtastwert
+
+/**
+ * @brief Toene des Akkords (Terzen ab c' in C-Dur), mindestens einer mehr als Stimmen fuer das Verdraengen.
+ */
+static const uint32_t chord[] = {
+    dds_tuning_word(262), dds_tuning_word(330), dds_tuning_word(392),
+    dds_tuning_word(494), dds_tuning_word(587), dds_tuning_word(659),
+    dds_tuning_word(784), dds_tuning_word(988), dds_tuning_word(1175)
+};
+static_assert(sizeof(chord) / sizeof(chord[0]) > DDS_VOICES, "chord needs DDS_VOICES + 1 notes");
+
+int main() { // Changed from main(void) to int main()
+    lcd_init();
+    lcd_enable(true);
+    dds_init();
+    sei();
+
+    while (true) { // Use true instead of 1 for C++
+        for (uint8_t notes = 0; notes <= DDS_VOICES + 1; notes++) {
+            if (notes > 0)
+                dds_noteOn(notes - 1, chord[notes - 1], DDS_LEVEL_MAX);
+
+            // Eine Sekunde messen //
+            uint8_t active = dds_voicesActive();
+            dds_cycles(active);
+            dds_clipped();
+            _delay_ms(1000);
+            uint16_t cycles = dds_cycles(active);
+            uint16_t clipped = dds_clipped();
+
+            lcd_bufferClear();
+            text_lcd(0, 0, "St", text_dec<2>(active), " ISR", text_dec<4>(cycles), "/", text_dec<3>(CYCLE_BUDGET));
+            text_lcd(0, 1, "Rest", text_dec<4>(static_cast<int16_t>(CYCLE_BUDGET - cycles)), " Sat", text_dec<4>(clipped));
+            lcd_flush();
+        }
+
+        for (uint8_t key = 0; key <= DDS_VOICES; key++)
+            dds_noteOff(key);
+        while (dds_voicesActive() != 0); // Ausklingen (Release) abwarten
+    }
+    return 0; // Added return 0 for int main()
+}
@@ -1,78 +1,61 @@
 #include <avr/io.h>
 #include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
+#include <avr/interrupt.h>
 #include "I2C_LCD.h"
+#include "AVR128DB48_ADC.h"
+#include "ADC_Scale.h"
+#include "Stream_Filter.h"
+
+#define BATCH 16 // Samples averaged per display update (power of two, the mean is a shift)
 
 // Buffers for strings
-char buffer[16];  // Buffer for voltage
-char buffer1[16]; // Buffer for percentage
+char buffer[ADC_SCALE_TEXT_SIZE];  // Buffer for voltage
+char buffer1[ADC_SCALE_TEXT_SIZE]; // Buffer for percentage
+
+// Fixed-point scale of each displayed channel (no soft-float)
+adc_channel_scale voltage_scale; // 10mV units: 330 = 3.30V (VREF = VDD)
+adc_channel_scale percent_scale; // 0.1% units: 1000 = 100.0%
 
 // Previous values for stable display
-float prev_voltage = -1.0f;   // To track voltage changes
-float prev_percent = -1.0f;   // To track percentage changes
+int32_t prev_voltage = -1;   // To track voltage changes
+int32_t prev_percent = -1;   // To track percentage changes
+
+// Samples taken out of the ADC ring
+uint16_t samples[BATCH];
+
+// Removes single spikes (e.g. switching lamps) before the mean
+median_filter<uint16_t, 5> spike_filter;
 
 // Prototypes
 void init_ADC(); // Removed void from parameter list for C++
 uint16_t read_ADC(); // Removed void from parameter list for C++
-void update_lcd_if_changed(float voltage, float percent);
-void float_to_ascii(float value, char *buf, int decimal_places, char unit);
+void update_lcd_if_changed(int32_t voltage, int32_t percent);
 
-// Initialize ADC
+// Initialize ADC: free-running on PF2, the samples are collected by the ADC interrupt
 void init_ADC() {
     PORTF.DIRCLR = PIN2_bm;                    // Set PF2 as input (photoresistor)
-    VREF.ADC0REF = VREF_REFSEL_VDD_gc;         // Use VDD (3.3V) as reference voltage
-    ADC0.MUXPOS = ADC_MUXPOS_AIN18_gc;         // Select PF2 (AIN18) as ADC input channel
-    ADC0.CTRLB = ADC_RESSEL_12BIT_gc;          // Configure ADC for 12-bit resolution
-    ADC0.CTRLA = ADC_ENABLE_bm;                // Enable ADC
-    ADC0.CTRLC = ADC_PRESC_DIV4_gc;            // Set prescaler (adjust ADC clock to be within spec)
+    adc_init();                                // VDD (3.3V) as reference, 12-bit resolution
+    adc_startFreeRunning(ADC_MUXPOS_AIN18_gc); // PF2 (AIN18), converts continuously
+    sei();                                     // Samples arrive from ADC0_RESRDY_vect
 }
 
-// Read ADC value
+// Mean of the next batch of samples (waits only until the batch is complete)
 uint16_t read_ADC() {
-    ADC0.COMMAND = ADC_STCONV_bm;              // Start ADC conversion
-    while (!(ADC0.INTFLAGS & ADC_RESRDY_bm));  // Wait for conversion to complete
-    ADC0.INTFLAGS = ADC_RESRDY_bm;             // Clear interrupt flag
-    return ADC0.RES;                           // Return result
-}
-
-// Convert floating-point value to ASCII string
-void float_to_ascii(float value, char *buf, int decimal_places, char unit) {
-    int whole_part = static_cast<int>(value);                        // Extract whole part
-    int fractional_part = static_cast<int>((value - whole_part) * 10 * decimal_places); // Extract fractional part
-
-    // Convert whole part
-    int i = 0;
-    if (whole_part == 0) {
-        buf[i++] = '0';
-    } else {
-        char temp[8];
-        int j = 0;
-        while (whole_part > 0) {
-            temp[j++] = static_cast<char>((whole_part % 10) + '0'); // C++ style cast
-            whole_part /= 10;
-        }
-        while (j > 0) {
-            buf[i++] = temp[--j];
-        }
-    }
-
-    // Add decimal point and fractional part
-    buf[i++] = '.';
-    for (int d = 0; d < decimal_places; d++) {
-        buf[i++] = static_cast<char>((fractional_part % 10) + '0'); // C++ style cast
-        fractional_part /= 10;
-    }
+    while (adc_available() < BATCH);           // ~3ms at ~5.4k samples per second
+    adc_readSamples(samples, BATCH);
 
-    // Add unit and null-terminate
-    buf[i++] = unit;
-    buf[i] = '\0';
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < BATCH; i++)
+        sum += spike_filter.update(samples[i]);
+    return static_cast<uint16_t>((sum + BATCH / 2) / BATCH); // Rounded mean
 }
 
 // Update LCD only if values have changed
-void update_lcd_if_changed(float voltage, float percent) {
+void update_lcd_if_changed(int32_t voltage, int32_t percent) {
     // Update voltage if it changed
     if (voltage != prev_voltage) {
         lcd_moveCursor(0, 0); // Move to the first line
-        float_to_ascii(voltage, buffer, 2, 'V'); // Convert voltage to ASCII
+        adc_scale_format(&voltage_scale, voltage, buffer); // Convert voltage to ASCII, e.g. "3.30V"
         lcd_putString(buffer); // Display voltage
         prev_voltage = voltage; // Update previous value
     }
@@ -80,8 +63,9 @@ void update_lcd_if_changed(float voltage, float percent) {
     // Update percentage if it changed
     if (percent != prev_percent) {
         lcd_moveCursor(0, 1); // Move to the second line
-        float_to_ascii(percent, buffer1, 1, '%'); // Convert percentage to ASCII
+        adc_scale_format(&percent_scale, percent, buffer1); // Convert percentage to ASCII, e.g. "80.5%"
         lcd_putString(buffer1); // Display percentage
+        lcd_putString(" "); // Clear the last character when "100.0%" gets shorter
         prev_percent = percent; // Update previous value
     }
 }
@@ -91,13 +75,15 @@ int main() { // Changed from main(void) to int main()
     lcd_init();
     lcd_enable(true);
     init_ADC();
+    adc_scale_setup(&voltage_scale, 330, 12, 2, 'V');  // V = RES * 3.30V / 4096
+    adc_scale_setup(&percent_scale, 1000, 12, 1, '%'); // P = RES * 100.0% / 4096
 
     while (true) { // Use true instead of 1 for C++
-        uint16_t adcValue = read_ADC(); // Read the ADC value
+        uint16_t adcValue = read_ADC(); // Mean of the samples collected meanwhile
 
-        // Calculate percentage and voltage
-        float percent = (adcValue * 100.0f) / 4095.0f; // Use .0f for float literals
-        float voltage = (adcValue * 3.3f) / 4095.0f; // Use .0f for float literals
+        // Calculate percentage and voltage (Q16 multiply, correctly rounded)
+        int32_t percent = adc_scale_apply(&percent_scale, adcValue);
+        int32_t voltage = adc_scale_apply(&voltage_scale, adcValue);
 
         // Update LCD only if necessary
         update_lcd_if_changed(voltage, percent);
@@ -1,32 +1,15 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include "song.h"
+#include "DDS_Tone.h"
+#include "No_Float.h"
 
 #define BUTTON_PINS (PIN2_bm | PIN3_bm | PIN4_bm | PIN5_bm | PIN6_bm | PIN7_bm)
 #define B_PIN (PIN0_bm)
 #define F_CPU (4000000UL)
-#define SINE_VALUE (64)
-//#define PER_VALUE (64)
 #define F_SIGNAL (a1)
 
-volatile uint8_t sine_index = 0;
-
-void init_dac()
-{
-	VREF.DAC0REF = VREF_REFSEL_2V048_gc;
-	//PORTD.PIN6CTRL = PORT_ISC_INPUT_DISABLE_gc; // Disable input on PD6
-	DAC0.CTRLA = DAC_OUTEN_bm;                  // Enable buffered output to PD6
-
-	// Step 3: Enable DAC
-	DAC0.CTRLA |= DAC_ENABLE_bm; // Enable DAC
-	DAC0.DATA = sine_table[0];
-}
-
-ISR(TCA0_OVF_vect) {
-	DAC0.DATA = static_cast<uint16_t>(sine_table[sine_index] << 6);       // Output sine wave value
-	sine_index = (sine_index + 1) % 64;       // Increment sine index
-	TCA0.SINGLE.INTFLAGS = TCA_SINGLE_OVF_bm; // Clear interrupt flag
-}
+constexpr uint32_t SIGNAL_TUNING = dds_tuning_word(F_SIGNAL); // Tuning word computed by the compiler
 
 /*ISR(PORTA_PORT_vect)
 {
@@ -34,10 +17,8 @@ ISR(TCA0_OVF_vect) {
 }*/
 
 int main() { // Changed from main(void) to int main()
-	init_dac();
-	TCA0.SINGLE.CTRLA = TCA_SINGLE_ENABLE_bm;
-	TCA0.SINGLE.PER = static_cast<uint16_t>(F_CPU / (F_SIGNAL * SINE_VALUE)); // Cast to uint16_t
-    TCA0.SINGLE.INTCTRL = TCA_SINGLE_OVF_bm;
+	dds_init();                                  // DAC on PD6, sample clock TCA0
+	dds_play(0, SIGNAL_TUNING);
 	/*PORTA.DIRCLR = BUTTON_PINS;
 	PORTB_DIRCLR = B_PIN;
 	
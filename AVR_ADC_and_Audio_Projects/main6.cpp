@@ -0,0 +1,125 @@
+#include <avr/io.h>
+#include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
+#define F_CPU 4000000UL
+#include <util/delay.h>
+#include "I2C_LCD.h"
+#include "ADC_Scale.h"
+#include "Cycle_Counter.h"
+#include "Int_Format.h"
+
+/**
+ * @file main6.cpp
+ * @brief Zyklen pro Messwert: bisheriger Float-Pfad gegen ADC_Scale (Festkomma).
+ *
+ * Der Float-Pfad ist die bisherige Umrechnung aus main1.cpp / main2.cpp
+ * (adcValue * 3.3f / 4095.0f und float_to_ascii()), der Festkomma-Pfad die neue
+ * (adc_scale_apply() und adc_scale_format()). Beide wandeln dieselben Messwerte
+ * (0 ... 4095 in 64 Schritten) in Spannung und Prozent samt Text um. Angezeigt werden
+ * die mittleren Zyklen pro Messwert (Cycle_Counter, TCB2).
+ */
+
+#define SAMPLES 64 ///< Messwerte pro Durchlauf (Zweierpotenz, der Mittelwert ist ein Shift)
+
+char buffer[ADC_SCALE_TEXT_SIZE];
+char buffer1[ADC_SCALE_TEXT_SIZE];
+
+adc_channel_scale voltage_scale; ///< 10mV-Einheiten
+adc_channel_scale percent_scale; ///< 0.1%-Einheiten
+
+/**
+ * @brief Bisherige Umwandlung (Referenz fuer die Messung, inklusive falscher Nachkommastellen).
+ */
+void float_to_ascii(float value, char *buf, int decimal_places, char unit) {
+    int whole_part = static_cast<int>(value);
+    int fractional_part = static_cast<int>((value - whole_part) * 10 * decimal_places);
+
+    int i = 0;
+    if (whole_part == 0) {
+        buf[i++] = '0';
+    } else {
+        char temp[8];
+        int j = 0;
+        while (whole_part > 0) {
+            temp[j++] = static_cast<char>((whole_part % 10) + '0');
+            whole_part /= 10;
+        }
+        while (j > 0) {
+            buf[i++] = temp[--j];
+        }
+    }
+
+    buf[i++] = '.';
+    for (int d = 0; d < decimal_places; d++) {
+        buf[i++] = static_cast<char>((fractional_part % 10) + '0');
+        fractional_part /= 10;
+    }
+
+    buf[i++] = unit;
+    buf[i] = '\0';
+}
+
+/**
+ * @brief Zyklen des Float-Pfads fuer einen Messwert.
+ *
+ * @param adcValue Simulierter Messwert (volatile gelesen, damit nichts vorausberechnet wird).
+ * @return Gemessene Zyklen.
+ */
+uint16_t measure_float(volatile uint16_t adcValue) {
+    uint16_t start = cycle_counter_now();
+    float percent = (adcValue * 100.0f) / 4095.0f;
+    float voltage = (adcValue * 3.3f) / 4095.0f;
+    float_to_ascii(voltage, buffer, 2, 'V');
+    float_to_ascii(percent, buffer1, 1, '%');
+    return cycle_counter_elapsed(start);
+}
+
+/**
+ * @brief Zyklen des Festkomma-Pfads fuer einen Messwert.
+ *
+ * @param adcValue Simulierter Messwert.
+ * @return Gemessene Zyklen.
+ */
+uint16_t measure_fixed(volatile uint16_t adcValue) {
+    uint16_t start = cycle_counter_now();
+    int32_t percent = adc_scale_apply(&percent_scale, adcValue);
+    int32_t voltage = adc_scale_apply(&voltage_scale, adcValue);
+    adc_scale_format(&voltage_scale, voltage, buffer);
+    adc_scale_format(&percent_scale, percent, buffer1);
+    return cycle_counter_elapsed(start);
+}
+
+int main() { // Changed from main(void) to int main()
+    char text[12];
+
+    lcd_init();
+    lcd_enable(true);
+    cycle_counter_init();
+    adc_scale_setup(&voltage_scale, 330, 12, 2, 'V');
+    adc_scale_setup(&percent_scale, 1000, 12, 1, '%');
+
+    while (true) { // Use true instead of 1 for C++
+        uint32_t float_cycles = 0;
+        uint32_t fixed_cycles = 0;
+
+        for (uint16_t i = 0; i < SAMPLES; i++) {
+            uint16_t adcValue = static_cast<uint16_t>(i * (4096 / SAMPLES) + i); // 0 ... 4095
+            float_cycles += measure_float(adcValue);
+            fixed_cycles += measure_fixed(adcValue);
+        }
+
+        // Zyklen pro Messwert
+        lcd_bufferClear();
+        lcd_bufferPutString(0, 0, "float:");
+        int_format_right(text, static_cast<int32_t>(float_cycles / SAMPLES), 6, ' ');
+        lcd_bufferPutString(7, 0, text);
+        lcd_bufferPutString(14, 0, "cy");
+        lcd_bufferPutString(0, 1, "fixed:");
+        int_format_right(text, static_cast<int32_t>(fixed_cycles / SAMPLES), 6, ' ');
+        lcd_bufferPutString(7, 1, text);
+        lcd_bufferPutString(14, 1, "cy");
+        lcd_flush();
+
+        _delay_ms(2000);
+    }
+    return 0; // Added return 0 for int main()
+}
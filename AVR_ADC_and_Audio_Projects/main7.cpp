@@ -0,0 +1,112 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
+#include "I2C_LCD.h"
+#include "AVR128DB48_ADC.h"
+#include "ADC_Scale.h"
+#include "Text_Format.h"
+
+/**
+ * @file main7.cpp
+ * @brief Potentiometer (PF3) und Fotowiderstand (PF2) in einer Firmware.
+ *
+ * Der ADC wandelt beide Eingaenge abwechselnd (adc_startScan()), jeder Messwert landet
+ * mit RTC-Zeitstempel im Ringpuffer seines Kanals. Die Hauptschleife holt die Werte
+ * blockweise ab und zeigt etwa viermal pro Sekunde den letzten Wert und die gemessene
+ * Rate jedes Kanals an (Summe beider Raten = adc_resultRate()).
+ */
+
+#define CHANNELS 2          ///< Anzahl der Eingaenge im Scan
+#define BATCH 8             ///< Messwerte pro Abholung und Kanal
+#define DISPLAY_TICKS 8192  ///< Anzeige alle 8192 / 32768 s = 250ms
+
+/// Eingaenge in Scan-Reihenfolge: Potentiometer, Fotowiderstand
+const uint8_t channels[CHANNELS] = {ADC_MUXPOS_AIN19_gc, ADC_MUXPOS_AIN18_gc};
+
+adc_channel_scale voltage_scale; ///< 10mV-Einheiten (Potentiometer)
+adc_channel_scale percent_scale; ///< 0.1%-Einheiten (Fotowiderstand)
+
+/// Zustand eines Kanals zwischen zwei Anzeigen
+struct channel_state {
+    uint16_t value;      ///< Letzter Messwert
+    uint16_t count;      ///< Messwerte seit der letzten Anzeige
+    uint32_t time;       ///< Zeitstempel des letzten Messwerts
+    uint32_t shown_time; ///< Zeitstempel des letzten Messwerts bei der letzten Anzeige
+};
+
+channel_state state[CHANNELS];
+adc_sample samples[BATCH];
+
+/**
+ * @brief Holt alle wartenden Messwerte eines Kanals ab.
+ *
+ * @param channel Index in channels.
+ */
+void drain_channel(uint8_t channel) {
+    uint8_t count;
+    while ((count = adc_readScan(channel, samples, BATCH)) != 0) {
+        state[channel].value = samples[count - 1].value;
+        state[channel].time = samples[count - 1].time;
+        state[channel].count += count;
+    }
+}
+
+/**
+ * @brief Messwerte pro Sekunde eines Kanals seit der letzten Anzeige.
+ *
+ * @param channel Index in channels.
+ * @return Rate aus Anzahl und Zeitspanne der Zeitstempel (0 ohne Messwerte).
+ */
+uint16_t channel_rate(uint8_t channel) {
+    uint32_t span = state[channel].time - state[channel].shown_time;
+    if (span == 0)
+        return 0;
+    return static_cast<uint16_t>((static_cast<uint32_t>(state[channel].count) * 32768UL) / span);
+}
+
+/**
+ * @brief Schreibt Wert und Rate eines Kanals in eine Zeile.
+ *
+ * @param channel Index in channels (= Zeile).
+ * @param name Kennbuchstabe des Kanals.
+ * @param scale Umrechnung des Messwerts.
+ */
+void show_channel(uint8_t channel, char name, const adc_channel_scale* scale) {
+    char text[ADC_SCALE_TEXT_SIZE];
+    adc_scale_format(scale, adc_scale_apply(scale, state[channel].value), text);
+
+    text_lcd(0, channel, name, ' ', text);
+    text_lcd(9, channel, text_dec<5>(channel_rate(channel)), "/s");
+
+    state[channel].count = 0;
+    state[channel].shown_time = state[channel].time;
+}
+
+int main() { // Changed from main(void) to int main()
+    lcd_init();
+    lcd_enable(true);
+
+    PORTF.DIRCLR = PIN2_bm | PIN3_bm; // PF2 und PF3 als Eingang
+    adc_init();
+    adc_scale_setup(&voltage_scale, 330, adc_resolution(), 2, 'V');
+    adc_scale_setup(&percent_scale, 1000, adc_resolution(), 1, '%');
+    adc_startScan(channels, CHANNELS);
+    sei();
+
+    uint32_t shown = 0;
+
+    while (true) { // Use true instead of 1 for C++
+        for (uint8_t i = 0; i < CHANNELS; i++)
+            drain_channel(i);
+
+        if (state[0].time - shown >= DISPLAY_TICKS) {
+            shown = state[0].time;
+
+            lcd_bufferClear();
+            show_channel(0, 'P', &voltage_scale);
+            show_channel(1, 'L', &percent_scale);
+            lcd_flush();
+        }
+    }
+    return 0; // Added return 0 for int main()
+}
@@ -0,0 +1,74 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
+#include "I2C_LCD.h"
+#include "AVR128DB48_ADC.h"
+#include "ADC_Scale.h"
+#include "Text_Format.h"
+
+/**
+ * @file main8.cpp
+ * @brief Fotowiderstand (PF2) mit exakt 1000 Messungen pro Sekunde.
+ *
+ * TCB0 startet jede Wandlung ueber das Event-System (adc_startTimed()), die Abtastzeitpunkte
+ * haengen also nicht davon ab, wie lange die Hauptschleife fuer das LCD braucht. Die
+ * Hauptschleife aktualisiert das LCD so oft sie kann (I2C dauernd belegt) und zeigt
+ * einmal pro Sekunde die Statistik der ADC-Interrupts:
+ * - Zeile 1: Mittelwert der letzten Sekunde und der aktuelle Messwert,
+ * - Zeile 2: kleinste und groesste Zeit vom Trigger bis zum Interrupt in Zyklen
+ *   und verlorene Messwerte (Ringpuffer voll).
+ * Solange der groesste Wert unter der Periode (4000 Zyklen) bleibt, geht kein Messwert
+ * verloren; die Messwerte selbst haben unabhaengig davon den exakten Abstand von 1ms.
+ */
+
+#define RATE 1000  ///< Messungen pro Sekunde
+#define BATCH 16   ///< Messwerte pro Abholung
+
+adc_channel_scale percent_scale; ///< 0.1%-Einheiten
+uint16_t samples[BATCH];
+
+int main() { // Changed from main(void) to int main()
+    lcd_init();
+    lcd_enable(true);
+
+    PORTF.DIRCLR = PIN2_bm; // PF2 als Eingang
+    adc_init();
+    adc_scale_setup(&percent_scale, 1000, adc_resolution(), 1, '%');
+    adc_startTimed(ADC_MUXPOS_AIN18_gc, RATE);
+    sei();
+
+    uint32_t sum = 0;       // Summe der Messwerte der laufenden Sekunde
+    uint16_t count = 0;     // Anzahl der Messwerte der laufenden Sekunde
+    uint16_t last = 0;      // Letzter Messwert
+    char text[ADC_SCALE_TEXT_SIZE];
+
+    while (true) { // Use true instead of 1 for C++
+        uint8_t n;
+        while ((n = adc_readSamples(samples, BATCH)) != 0) {
+            for (uint8_t i = 0; i < n; i++)
+                sum += samples[i];
+            count += n;
+            last = samples[n - 1];
+        }
+
+        // Jede Runde neu zeichnen: haelt I2C und CPU beschaeftigt //
+        adc_scale_format(&percent_scale, adc_scale_apply(&percent_scale, last), text);
+        text_lcd(10, 0, text, "  ");
+
+        if (count >= RATE) {
+            adc_timing timing;
+            adc_readTiming(&timing, true);
+
+            uint16_t mean = static_cast<uint16_t>(sum / count);
+            adc_scale_format(&percent_scale, adc_scale_apply(&percent_scale, mean), text);
+            text_lcd(0, 0, text, "   ");
+            text_lcd(0, 1, text_dec<4>(timing.latency_min), '-', text_dec<4>(timing.latency_max), "cy ov", text_dec<2>(adc_overflows()));
+
+            sum = 0;
+            count = 0;
+        }
+
+        lcd_flush();
+    }
+    return 0; // Added return 0 for int main()
+}
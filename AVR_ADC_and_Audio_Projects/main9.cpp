@@ -0,0 +1,85 @@
+#include <avr/io.h>
+#include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
+#define F_CPU 4000000UL
+#include <util/delay.h>
+#include "I2C_LCD.h"
+#include "Stream_Filter.h"
+#include "Cycle_Counter.h"
+#include "Text_Format.h"
+
+/**
+ * @file main9.cpp
+ * @brief Zyklen pro Messwert der Filter aus Stream_Filter.h.
+ *
+ * Jeder Filter bekommt dieselben simulierten 12-Bit-Messwerte (Rampe mit Rauschen und
+ * einzelnen Ausreissern). Angezeigt werden die mittleren Zyklen pro update() (Cycle_Counter, TCB2):
+ *   Zeile 1: moving_average<16> und iir_filter<3>
+ *   Zeile 2: median_filter<5> und kalman_filter (nach dem Einschwingen, ohne Division)
+ * Durchsatz und Genauigkeit auf dem PC: Stream_Filter_Host.cpp.
+ */
+
+#define SAMPLES 256 ///< Messwerte pro Durchlauf (Zweierpotenz, der Mittelwert ist ein Shift)
+
+moving_average<uint16_t, 16> average;
+iir_filter<uint16_t, 3> smooth;
+median_filter<uint16_t, 5> median;
+kalman_filter<uint16_t> kalman(1, 400);
+
+uint16_t samples[SAMPLES];
+
+/**
+ * @brief Simulierte Messwerte: Rampe, +-8 LSB Rauschen, jeder 32. Wert ein Ausreisser.
+ */
+void make_samples() {
+    uint16_t noise = 0x1234;
+    for (uint16_t i = 0; i < SAMPLES; i++) {
+        noise = static_cast<uint16_t>(noise * 25173U + 13849U);
+        uint16_t value = static_cast<uint16_t>(i * 16 + (noise >> 12));
+        samples[i] = (i % 32 == 0) ? 4095 : value;
+    }
+}
+
+/**
+ * @brief Mittlere Zyklen pro update() eines Filters.
+ *
+ * @param filter Zu messender Filter.
+ * @return Zyklen pro Messwert (inklusive der Schleife und des Lesens von samples).
+ */
+template <typename Filter>
+uint16_t measure(Filter& filter) {
+    uint32_t cycles = 0;
+    volatile uint16_t sink;
+    for (uint16_t i = 0; i < SAMPLES; i++) {
+        uint16_t start = cycle_counter_now();
+        sink = filter.update(samples[i]);
+        cycles += cycle_counter_elapsed(start);
+    }
+    (void)sink;
+    return static_cast<uint16_t>(cycles / SAMPLES);
+}
+
+int main() { // Changed from main(void) to int main()
+    lcd_init();
+    lcd_enable(true);
+    cycle_counter_init();
+    make_samples();
+
+    // Kalman einschwingen lassen: danach keine Division mehr //
+    for (uint16_t i = 0; i < SAMPLES; i++)
+        kalman.update(samples[i]);
+
+    while (true) { // Use true instead of 1 for C++
+        uint16_t average_cycles = measure(average);
+        uint16_t smooth_cycles = measure(smooth);
+        uint16_t median_cycles = measure(median);
+        uint16_t kalman_cycles = measure(kalman);
+
+        lcd_bufferClear();
+        text_lcd(0, 0, "avg", text_dec<4>(average_cycles), " iir", text_dec<4>(smooth_cycles));
+        text_lcd(0, 1, "med", text_dec<4>(median_cycles), " kal", text_dec<4>(kalman_cycles));
+        lcd_flush();
+
+        _delay_ms(2000);
+    }
+    return 0; // Added return 0 for int main()
+}
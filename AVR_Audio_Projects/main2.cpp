@@ -2,11 +2,12 @@
 #include <avr/interrupt.h>
 // #include <stdio.h> // Not strictly needed for this C++ conversion unless printf is used
 #include "song.h"
+#include "DDS_Tone.h"
+#include "Note_Table.h"
+#include "No_Float.h"
 
 #define F_CPU 4000000UL
 
-#define TCA_PER(x) static_cast<uint16_t>(F_CPU / (static_cast<float>(x) * 64) - 1) // Cast to float for division
-
 #define BUTTON_PINS (PIN2_bm | PIN3_bm | PIN4_bm | PIN5_bm | PIN6_bm | PIN7_bm)
 
 /**
@@ -15,90 +16,59 @@
 volatile uint16_t millis = 0;
 
 /**
- * @brief Aktuell gespielte Note.
- */
-volatile uint8_t current_note = mute;
-
-/**
- * @brief Aktueller Index in der Sinustabelle.
+ * @brief Tasten der Klaviatur an Port A und ihre Tuning Words (vom Compiler berechnet).
+ *
+ * Die Taste an PB0 (Note a) hat die Nummer KEY_COUNT, ihr Ton steht als letzter in key_notes.
  */
-volatile uint8_t sine_index = 0;
+#define KEY_COUNT 6
+static const uint8_t key_pins[KEY_COUNT] = {PIN2_bm, PIN3_bm, PIN4_bm, PIN5_bm, PIN6_bm, PIN7_bm};
+typedef note_table<c, d, e, f, g, h, a> key_notes;
+static_assert(key_notes::count == KEY_COUNT + 1, "one note per key, the last one for PB0");
 
 /**
- * @brief Initialisiert den DAC.
+ * @brief Zuletzt gesehener Zustand der Tasten an Port A.
  */
-void init_dac(); // Removed void from parameter list for C++
+volatile uint8_t keys_down = 0;
 
 /**
- * @brief ISR fr die Tasten am Port B.
+ * @brief ISR fr die Taste am Port B.
  */
 ISR(PORTB_PORT_vect) {
     if (PORTB.IN & PIN0_bm) {
-        current_note = a;
-        TCA0.SINGLE.PER = TCA_PER(a);
-        TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
+        dds_noteOn(KEY_COUNT, key_notes::tuning[KEY_COUNT]);
     } else {
-        current_note = mute;
-        TCA0.SINGLE.CTRLA &= ~TCA_SINGLE_ENABLE_bm;
+        dds_noteOff(KEY_COUNT);
     }
     PORTB.INTFLAGS = PIN0_bm;
 }
 
 /**
  * @brief ISR fr die Tasten am Port A.
+ *
+ * Jede gedrueckte Taste bekommt eine eigene DDS-Stimme (polyphon, bis DDS_VOICES Toene),
+ * beim Loslassen endet nur ihr eigener Ton.
  */
 ISR(PORTA_PORT_vect) {
-    if (PORTA.IN & PIN2_bm) {
-        current_note = c;
-        TCA0.SINGLE.PER = TCA_PER(c);
-        TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-    } else if (PORTA.IN & PIN3_bm) {
-        current_note = d;
-        TCA0.SINGLE.PER = TCA_PER(d);
-        TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-    } else if (PORTA.IN & PIN4_bm) {
-        current_note = e;
-        TCA0.SINGLE.PER = TCA_PER(e);
-        TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-    } else if (PORTA.IN & PIN5_bm) {
-        current_note = f;
-        TCA0.SINGLE.PER = TCA_PER(f);
-        TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-    } else if (PORTA.IN & PIN6_bm) {
-        current_note = g;
-        TCA0.SINGLE.PER = TCA_PER(g);
-        TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-    } else if (PORTA.IN & PIN7_bm) {
-        current_note = h;
-        TCA0.SINGLE.PER = TCA_PER(h);
-        TCA0.SINGLE.CTRLA |= TCA_SINGLE_ENABLE_bm;
-    }
-    } else {
-        current_note = mute;
-        TCA0.SINGLE.CTRLA &= ~TCA_SINGLE_ENABLE_bm;
-        DAC0.CTRLA &= ~DAC_ENABLE_bm;
-    }
     PORTA.INTFLAGS = BUTTON_PINS;
-}
+    uint8_t pressed = PORTA.IN & BUTTON_PINS;
+    uint8_t changed = pressed ^ keys_down;
+    keys_down = pressed;
 
-/**
- * @brief ISR fr den Timer nach einem berlauf des Zhlers.
- */
-ISR(TCA0_OVF_vect) {
-    if (current_note != mute) {
-        DAC0.CTRLA |= DAC_ENABLE_bm;  // DAC aktivieren
-        DAC0.DATA = static_cast<uint16_t>(sine_table[sine_index] << 6); // Cast to uint16_t
-        sine_index = (sine_index + 1) % 64;
-    } else {
-        DAC0.CTRLA &= ~DAC_ENABLE_bm;  // DAC deaktivieren
+    for (uint8_t key = 0; key < KEY_COUNT; key++) {
+        if (!(changed & key_pins[key]))
+            continue;
+        if (pressed & key_pins[key]) {
+            dds_noteOn(key, key_notes::tuning[key]);
+        } else {
+            dds_noteOff(key);
+        }
     }
-    TCA0.SINGLE.INTFLAGS = TCA_SINGLE_OVF_bm;
 }
 
 /**
  * @brief Hauptfunktion.
  * 
- * Konfiguriert die Tasten als Eingnge und initialisiert den DAC.
+ * Konfiguriert die Tasten als Eingnge und initialisiert DAC und Abtasttakt (DDS_Tone).
  * Die Hauptschleife bleibt leer, die Interrupts behandeln die Tastendrcke.
  */
 int main() { // Changed from main(void) to int main()
@@ -113,12 +83,8 @@ int main() { // Changed from main(void) to int main()
     PORTA.PIN7CTRL = PORT_ISC_BOTHEDGES_gc;
     PORTB.PIN0CTRL = PORT_ISC_BOTHEDGES_gc;
 
-    init_dac();
-
-    // Timer/Counter TCA0 Konfiguration
-    TCA0.SINGLE.INTCTRL = TCA_SINGLE_OVF_bm;
-    TCA0.SINGLE.CTRLA = TCA_SINGLE_CLKSEL_DIV1_gc;
-    TCA0.SINGLE.PER = TCA_PER(mute);
+    dds_init(); // DAC und Abtasttakt (TCA0, feste Abtastrate), alle Stimmen stumm
+    dds_setEnvelope(5, 600, 140, 250); // Angeschlagen: 5ms Anstieg, abklingen auf ~55%, 250ms Ausklang
 
     sei();
 
@@ -0,0 +1,76 @@
+#include <avr/io.h>
+#include <stdio.h> // sprintf() as reference
+#include "I2C_LCD.h"
+#include "Text_Format.h"
+#include "Cycle_Counter.h"
+
+#define F_CPU 4000000UL ///< CPU frequency
+#include <util/delay.h>
+
+/**
+ * @file format_benchmark.cpp
+ * @brief Cycles of the "C:" call site of i_2_c.cpp: sprintf() against Text_Format.
+ *
+ * Both variants write the clear channel value into the screen buffer:
+ * - sprintf(buf, "C:%u", value) + lcd_bufferPutString() (former code),
+ * - text_lcd(9, 1, "C:", value) (current code).
+ * The average cycles per call over a range of values are shown on the LCD.
+ *
+ * Flash: this file links both variants. The flash saving is the difference of the
+ * avr-size output of i_2_c.cpp built before and after the change (vfprintf, the
+ * format parser and the stdio support are no longer linked).
+ */
+
+#define CALLS 64 ///< Calls per measurement
+
+char color_buf[10]; ///< Buffer of the sprintf variant
+
+/**
+ * @brief Cycles of the former call site.
+ *
+ * @param value Clear channel value.
+ * @return uint16_t Measured cycles.
+ */
+uint16_t measure_sprintf(uint16_t value) {
+    uint16_t start = cycle_counter_now();
+    sprintf(color_buf, "C:%u", value);
+    lcd_bufferPutString(9, 1, color_buf);
+    return cycle_counter_elapsed(start);
+}
+
+/**
+ * @brief Cycles of the current call site.
+ *
+ * @param value Clear channel value.
+ * @return uint16_t Measured cycles.
+ */
+uint16_t measure_text_format(uint16_t value) {
+    uint16_t start = cycle_counter_now();
+    text_lcd(9, 1, "C:", value);
+    return cycle_counter_elapsed(start);
+}
+
+int main() { // Changed from main(void) to int main()
+    lcd_init();
+    lcd_enable(true);
+    cycle_counter_init();
+
+    while (true) { // Use true instead of 1 for C++
+        uint32_t sprintf_cycles = 0;
+        uint32_t text_cycles = 0;
+
+        for (uint16_t i = 0; i < CALLS; i++) {
+            volatile uint16_t value = static_cast<uint16_t>(i * 1021); // 0 ... 64323, all lengths
+            sprintf_cycles += measure_sprintf(value);
+            text_cycles += measure_text_format(value);
+        }
+
+        lcd_bufferClear();
+        text_lcd(0, 0, "sprintf:", text_dec<6>(sprintf_cycles / CALLS), "cy");
+        text_lcd(0, 1, "text:   ", text_dec<6>(text_cycles / CALLS), "cy");
+        lcd_flush();
+
+        _delay_ms(2000);
+    }
+    return 0; // Added return 0 for int main()
+}
@@ -1,19 +1,24 @@
 #include <avr/io.h>
-#include <stdio.h> // Keep for sprintf
 #include "I2C_LCD.h"
+#include "Text_Format.h"
+#include "Stream_Filter.h"
 #include "AVR128DB48_I2C.h"
 
 #define F_CPU 4000000UL ///< CPU frequency
 #include <util/delay.h>
 #define TCS34725_ADDRESS 0x29 ///< TCS34725 I2C address
-#define SIZE 10 ///< Buffer size for displaying values
+#define BAR_WIDTH 7 ///< Cells per colour bar
 
 /**
  * @brief Global variables to store sensor data.
  */
 uint8_t read_bits[8]; ///< Buffer to store raw sensor data
 uint16_t clear_val, red_val, green_val, blue_val = 0; // Renamed to avoid conflict with color names
-char color_buf[SIZE] = ""; ///< Buffer for formatted display strings
+
+/**
+ * @brief Smoothing of every channel (time constant ~4 readings = 2 s), removes the sensor noise.
+ */
+iir_filter<uint16_t, 2> clear_filter, red_filter, green_filter, blue_filter;
 
 /**
  * @brief Initialize the TCS34725 sensor.
@@ -28,7 +33,8 @@ void i2c_initialize(); // Removed void from parameter list for C++
  * @brief Main program loop.
  *
  * The program initializes the LCD and the TCS34725 sensor, then continuously 
- * reads color data from the sensor and displays the values on the LCD.
+ * reads color data from the sensor and displays the values on the LCD
+ * (red, green and blue as bar graphs relative to the clear channel).
  *
  * @return int Returns 0 on successful execution (not used in embedded systems).
  */
@@ -38,11 +44,9 @@ int main() { // Changed from main(void) to int main()
     i2c_initialize();    ///< Initialize the TCS34725 sensor
 
     while (true) { // Use true instead of 1 for C++
-        // Request data from the sensor
+        // Request data from the sensor (register address + 8 data bytes in one transaction)
         uint8_t reg = static_cast<uint8_t>(0x80 | 0x14); ///< COMMAND_BIT + STARTING REGISTER
-        i2c_write(TCS34725_ADDRESS, &reg, 1);
-        _delay_ms(30);
-        i2c_read(TCS34725_ADDRESS, read_bits, 8);
+        i2c_write_read(TCS34725_ADDRESS, &reg, 1, read_bits, 8);
 
         // Combine high and low bytes to form color values
         clear_val = static_cast<uint16_t>((read_bits[1] << 8) | read_bits[0]);
@@ -50,24 +54,36 @@ int main() { // Changed from main(void) to int main()
         green_val = static_cast<uint16_t>((read_bits[5] << 8) | read_bits[4]);
         blue_val  = static_cast<uint16_t>((read_bits[7] << 8) | read_bits[6]);
 
-        // Display values on LCD
-        lcd_clear();
+        // Smooth the readings (the first reading starts the filters without settling from 0)
+        static bool first_reading = true;
+        if (first_reading) {
+            clear_filter.reset(clear_val);
+            red_filter.reset(red_val);
+            green_filter.reset(green_val);
+            blue_filter.reset(blue_val);
+            first_reading = false;
+        }
+        clear_val = clear_filter.update(clear_val);
+        red_val   = red_filter.update(red_val);
+        green_val = green_filter.update(green_val);
+        blue_val  = blue_filter.update(blue_val);
+
+        // Display values on LCD (only changed characters are sent)
+        // Bars show each colour relative to the clear channel, 7 cells = 35 steps
+        lcd_bufferClear();
+
+        lcd_bufferPutChar(0, 0, 'R');
+        lcd_bufferPutBar(1, 0, BAR_WIDTH, red_val, clear_val);
 
-        lcd_moveCursor(0, 0);
-        sprintf(color_buf, "C:%d", clear_val);
-        lcd_putString(color_buf);
+        lcd_bufferPutChar(8, 0, 'G');
+        lcd_bufferPutBar(9, 0, BAR_WIDTH, green_val, clear_val);
 
-        lcd_moveCursor(9, 0);
-        sprintf(color_buf, "R:%d", red_val);
-        lcd_putString(color_buf);
+        lcd_bufferPutChar(0, 1, 'B');
+        lcd_bufferPutBar(1, 1, BAR_WIDTH, blue_val, clear_val);
 
-        lcd_moveCursor(0, 1);
-        sprintf(color_buf, "G:%d", green_val);
-        lcd_putString(color_buf);
+        text_lcd(9, 1, "C:", clear_val); // Typed output, no sprintf / vfprintf in flash
 
-        lcd_moveCursor(9, 1);
-        sprintf(color_buf, "B:%d", blue_val);
-        lcd_putString(color_buf);
+        lcd_flush();
 
         _delay_ms(500); ///< Delay to avoid excessive updates
     }
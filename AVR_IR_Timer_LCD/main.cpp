@@ -3,6 +3,8 @@
 #include <avr/interrupt.h>
 #include <util/delay.h>
 #include "I2C_LCD.h"
+#include "Cycle_Counter.h"
+#include "Int_Format.h"
 
 
 // Definitions
@@ -12,6 +14,7 @@
 #define NEC_BIT_0_MAX 1500        ///< Maximum duration in µs for bit 0
 #define NEC_BIT_1_MIN 2000        ///< Minimum duration in µs for bit 1
 #define NEC_BIT_1_MAX 2600        ///< Maximum duration in µs for bit 1
+#define EVENT_TIME 0x01           ///< LCD event: remaining time changed
 
 // Global Variables
 volatile uint16_t remaining_time = 0;  ///< Remaining time in seconds
@@ -20,11 +23,13 @@ volatile uint32_t nec_data = 0;        ///< Storage for NEC data
 volatile uint8_t bit_index = 0;        ///< Current bit index
 volatile uint8_t decoding = 0;         ///< Decoding status
 char buf[32];                          ///< Buffer for LCD display
+volatile uint16_t isr_max_cycles = 0;  ///< Longest ISR run time measured so far (CPU cycles)
 
 // Function Prototypes
 void update_lcd(); // Removed void from parameter list for C++
+void render_lcd(uint8_t events);
+void track_isr_time(uint16_t start);
 void process_command(uint8_t command);
-char* integer_to_string(char *buf, int32_t num, int base);
 void configure_timer(); // Removed void from parameter list for C++
 void configure_ir_receiver(); // Removed void from parameter list for C++
 void handle_lcd_update(); // Removed void from parameter list for C++
@@ -32,54 +37,46 @@ void handle_timer_overflow(); // Removed void from parameter list for C++
 void handle_ir_signal(); // Removed void from parameter list for C++
 
 /**
- * @brief Converts an integer to a string representation.
+ * @brief Requests an update of the LCD.
  *
- * @param buf Buffer to store the resulting string.
- * @param num The integer to convert.
- * @param base The numerical base for the conversion.
- * @return char* Pointer to the resulting string.
+ * Safe to call from an ISR: only an event is posted, the main loop draws it (see render_lcd()).
  */
-char* integer_to_string(char *buf, int32_t num, int base) {
-    bool isNegative = false;
-    int digitCounter = 0;
-
-    if (num == 0) {
-        buf[digitCounter++] = '0';
-    }
-
-    if (num < 0) {
-        isNegative = true;
-        num = -num;
-    }
-
-    while (num > 0) {
-        buf[digitCounter++] = static_cast<char>('0' + num % base); // Cast to char
-        num /= base;
-    }
-
-    if (isNegative) {
-        buf[digitCounter++] = '-';
-    }
-
-    buf[digitCounter] = '\0';
-
-    // Reverse the string
-    for (int i = 0, j = digitCounter - 1; i < j; i++, j--) {
-        char temp = buf[i];
-        buf[i] = buf[j];
-        buf[j] = temp;
-    }
+void update_lcd() {
+    lcd_post(EVENT_TIME);
+}
 
-    return buf;
+/**
+ * @brief Draws the remaining time and the longest ISR run time into the screen buffer.
+ *
+ * Called by lcd_service() in the main loop, the changed characters are flushed afterwards.
+ *
+ * @param events Events posted since the last call.
+ */
+void render_lcd(uint8_t events) {
+    if (!(events & EVENT_TIME))
+        return; // Nothing this renderer draws has changed
+
+    cli(); // 16-bit values are written by the ISRs
+    uint16_t time = remaining_time;
+    uint16_t cycles = isr_max_cycles;
+    sei();
+
+    lcd_bufferClear();
+    lcd_bufferPutString(0, 0, integer_to_string(buf, time, 10));
+    lcd_bufferPutString(0, 1, "ISR max:");
+    lcd_bufferPutString(9, 1, integer_to_string(buf, cycles, 10));
 }
 
 /**
- * @brief Updates the content of the LCD.
+ * @brief Updates the longest ISR run time.
+ *
+ * @param start Value of cycle_counter_now() at the start of the ISR.
  */
-void update_lcd() {
-    lcd_clear();
-    lcd_putString(integer_to_string(buf, remaining_time, 10));
-    lcd_moveCursor(0, 0);
+void track_isr_time(uint16_t start) {
+    uint16_t cycles = cycle_counter_elapsed(start);
+    if (cycles > isr_max_cycles) {
+        isr_max_cycles = cycles;
+    }
 }
 
 /**
@@ -113,6 +110,7 @@ void process_command(uint8_t command) {
  * @brief ISR for detecting edges on the IR receiver pin.
  */
 ISR(PORTC_PORT_vect) {
+    uint16_t isr_start = cycle_counter_now();
     static uint16_t pulse_width = 0;
     uint16_t current_time = TCA0.SINGLE.CNT;
     TCA0.SINGLE.CNT = 0; // Reset the timer counter
@@ -147,12 +145,14 @@ ISR(PORTC_PORT_vect) {
     }
 
     PORTC.INTFLAGS = PIN3_bm; // Clear interrupt flag
+    track_isr_time(isr_start);
 }
 
 /**
  * @brief ISR for timer overflow.
  */
 ISR(TCA0_OVF_vect) {
+    uint16_t isr_start = cycle_counter_now();
     if (static_cast<bool>(timer_running) && remaining_time > 0) { // Cast to bool
         remaining_time--;
         update_lcd();
@@ -163,6 +163,7 @@ ISR(TCA0_OVF_vect) {
         }
     }
     TCA0.SINGLE.INTFLAGS = TCA_SINGLE_OVF_bm; // Clear interrupt flag
+    track_isr_time(isr_start);
 }
 
 /**
@@ -186,9 +187,12 @@ void configure_ir_receiver() {
  * @brief Main function.
  *
  * Initializes peripherals and enters an infinite loop to process IR signals and timer events.
+ * The ISRs never touch the display; the main loop renders the posted events.
  */
 int main() { // Changed from main(void) to int main()
     lcd_init();
+    lcd_setRenderer(render_lcd);
+    cycle_counter_init();
     PORTE.DIRSET = PIN0_bm; // Set LED as output
     PORTE.OUTCLR = PIN0_bm;
 
@@ -199,7 +203,7 @@ int main() { // Changed from main(void) to int main()
     update_lcd();
 
     while (true) { // Use true instead of 1 for C++
-        // Main loop
+        lcd_service(); // Draw posted LCD events
     }
     return 0; // Added return 0 for int main()
 }
\ No newline at end of file
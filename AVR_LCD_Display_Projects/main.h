@@ -24,6 +24,7 @@
 
 #include <avr/io.h>
 #include <I2C_LCD.h>
+#include "Int_Format.h"      // integer_to_string()
 #include <util/delay.h>
 #include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
 
@@ -43,18 +44,23 @@ void count_up(); // Removed void from parameter list for C++
 void ping_pong(); // Removed void from parameter list for C++
 
 /**
- * @brief Konvertiert eine Ganzzahl in eine Zeichenkette.
- * 
- * @param buf Puffer fr die Ausgabe.
- * @param num Die Zahl, die umgewandelt werden soll.
- * @param base Die Basis (z. B. 10 fr Dezimal, 2 fr Biner).
- * @return Zeiger auf den Puffer.
+ * @brief Binerer Taschenrechner mit LCD-Ausgabe und Tastensteuerung.
  */
-extern char* integer_to_string(char *buf, int32_t num, int base);
+void binary_calculator_lcd(); // Removed void from parameter list for C++
 
 /**
- * @brief Binerer Taschenrechner mit LCD-Ausgabe und Tastensteuerung.
+ * @brief Misst die Ausfuehrungszeit der LCD-Befehle ueber das Busy-Flag.
  */
-void binary_calculator_lcd(); // Removed void from parameter list for C++
+void lcd_latency_benchmark(); // Removed void from parameter list for C++
+
+/**
+ * @brief Zaehler auf einem 16x2- und einem 20x4-Display am selben Bus.
+ */
+void dual_display_count(); // Removed void from parameter list for C++
+
+/**
+ * @brief Zyklenmessung: bisherige Ganzzahl-Umwandlung gegen Int_Format.
+ */
+void int_format_benchmark(); // Removed void from parameter list for C++
 
 #endif
\ No newline at end of file
@@ -5,7 +5,8 @@
  * @details
  * Dieses Programm animiert eine "1", die sich auf einem LCD-Bildschirm hin- und herbewegt. 
  * Die Animation wechselt die Zeile und Richtung, wenn der Rand des Displays erreicht wird. 
- * Der restliche Bereich der Zeilen wird mit "0" gefllt.
+ * Der restliche Bereich der Zeilen wird mit "0" gefllt. Die Bewegung nutzt die Display-Shift-Befehle 
+ * des HD44780 (lcd_scroll()).
  *
  * @author Danielou Mounsande
  * @date 28. November 2024
@@ -21,45 +22,44 @@
  * umgekehrt. Wenn die "1" den Rand erreicht, wird die Zeile gewechselt und die Richtung umgekehrt. 
  * Die Animation luft endlos.
  *
- * @note Der Bildschirm wird bei jedem Zeilenwechsel gelscht.
+ * Beide 40 Zeichen langen DDRAM-Zeilen werden einmal mit "0" gefuellt, die "1" steht immer an 
+ * Adresse 0 der aktuellen Zeile. Bewegt wird sie durch Verschieben des sichtbaren Fensters 
+ * (lcd_scroll()): ein Befehlsbyte pro Schritt statt 16 Zeichen. Beim Zeilenwechsel aendern 
+ * sich nur zwei Zeichen, der Bildschirm wird nicht mehr geloescht.
  */
 void ping_pong() {
-    char line1[LCD_WIDTH + 1] = {0}; 
-    char line2[LCD_WIDTH + 1] = {0};
+    char line[LCD_LINE_LENGTH + 1] = {0};
 
     int position = 0;   /**< Aktuelle Position der "1". */
     int direction = 1;  /**< Richtung der Bewegung (1 = rechts, -1 = links). */
     int current_row = 0; /**< Aktuelle Zeile (0 = obere Zeile, 1 = untere Zeile). */
 
-    while (true) { // Use true instead of 1 for C++
-        // Setze die Zeilen zurck
-        for (int i = 0; i < LCD_WIDTH; i++) {
-            line1[i] = line2[i] = '0';
-        }
-
-        // Aktualisiere die "1" in der entsprechenden Zeile
-        if (current_row == 0) {
-            line1[position] = '1';
-            lcd_moveCursor(0, 0);
-            lcd_putString(line1);
-        } else {
-            line2[position] = '1';
-            lcd_moveCursor(0, 1);
-            lcd_putString(line2);
-        }
+    for (int i = 0; i < LCD_LINE_LENGTH; i++) {
+        line[i] = '0';
+    }
 
-        _delay_ms(WAIT);
+    while (true) { // Use true instead of 1 for C++
+        // Neue Zeile: die "1" steht an der aktuellen Position (Adresse 0 der Zeile)
+        line[0] = '1';
+        lcd_bufferPutLine(static_cast<uint8_t>(current_row), line);
+        line[0] = '0';
+        lcd_bufferPutLine(static_cast<uint8_t>(1 - current_row), line);
+        lcd_flush();
 
-        // Bewege die Position
-        position += direction;
+        // Die "1" bis zum Rand bewegen
+        while (true) {
+            _delay_ms(WAIT);
 
-        // Wechsel der Zeile und Richtung bei Erreichen des Randes
-        if (position == LCD_WIDTH || position < 0) {
-            lcd_clear();
-            direction = -direction;
-            current_row = 1 - current_row; // Zeilenwechsel
+            if (position + direction == LCD_WIDTH || position + direction < 0) {
+                break;
+            }
             position += direction;
+            lcd_scroll(static_cast<int8_t>(-direction)); // Inhalt nach rechts = "1" nach rechts
         }
+
+        // Wechsel der Zeile und Richtung bei Erreichen des Randes
+        direction = -direction;
+        current_row = 1 - current_row; // Zeilenwechsel
     }
 }
 
@@ -50,7 +50,6 @@ void binary_calculator_lcd() {
         // Erhhen des Zhlerwerts
         if ((PORTC.IN & PIN4_bm) == 0 && last_button == 0) {
             _delay_ms(WAITING_FOR_DEBOUNCING);
-            lcd_clear();
             if ((PORTC.IN & PIN4_bm) == 0) {
                 counter++;
                 last_button = PIN4_bm;
@@ -59,7 +58,6 @@ void binary_calculator_lcd() {
         // Verringern des Zhlerwerts
         else if ((PORTC.IN & PIN5_bm) == 0 && last_button == 0) {
             _delay_ms(WAITING_FOR_DEBOUNCING);
-            lcd_clear();
             if ((PORTC.IN & PIN5_bm) == 0) {
                 counter--;
                 last_button = PIN5_bm;
@@ -68,7 +66,6 @@ void binary_calculator_lcd() {
         // Linksshift
         else if ((PORTC.IN & PIN6_bm) == 0 && last_button == 0) {
             _delay_ms(WAITING_FOR_DEBOUNCING);
-            lcd_clear();
             if ((PORTC.IN & PIN6_bm) == 0) {
                 counter <<= 1;
                 last_button = PIN6_bm;
@@ -77,7 +74,6 @@ void binary_calculator_lcd() {
         // Rechtsshift
         else if ((PORTC.IN & PIN7_bm) == 0 && last_button == 0) {
             _delay_ms(WAITING_FOR_DEBOUNCING);
-            lcd_clear();
             if ((PORTC.IN & PIN7_bm) == 0) {
                 counter >>= 1;
                 last_button = PIN7_bm;
@@ -89,11 +85,12 @@ void binary_calculator_lcd() {
             last_button = 0;
         }
 
-        // Anzeige des aktuellen Werts auf dem LCD
+        // Anzeige des aktuellen Werts auf dem LCD (nur geaenderte Zeichen werden gesendet)
         integer_to_string(display, counter, 10);
-        lcd_moveCursor(0, 0);
-        lcd_putString("Dec: ");
-        lcd_putString(display);
+        lcd_bufferClear();
+        lcd_bufferPutString(0, 0, "Dec: ");
+        lcd_bufferPutString(5, 0, display);
+        lcd_flush();
     }
 }
 
@@ -0,0 +1,104 @@
+/**
+ * @file main5.c
+ * @brief Messung der tatsaechlichen Ausfuehrungszeit der LCD-Befehle.
+ *
+ * @details
+ * Dieses Programm sendet verschiedene HD44780-Befehle und liest danach das Busy-Flag, 
+ * bis der Controller wieder bereit ist. Die gemessene Zeit wird zusammen mit dem 
+ * Worst-Case-Wert aus dem Datenblatt auf dem LCD angezeigt. 
+ * Die Zeit wird mit dem Cycle_Counter (TCB2) gemessen.
+ *
+ * @note Ein Lesen des Busy-Flags dauert bei 100kHz ca. 1,1ms. Die Messung ist daher eine 
+ * obere Schranke mit einer Aufloesung von einem Lesevorgang; kurze Befehle (37us) 
+ * sind bereits beim ersten Lesen fertig.
+ *
+ * @date 16. Oktober 2026
+ */
+
+#include "main.h"
+#include "Cycle_Counter.h"
+
+/**
+ * @brief Ein zu messender Befehl.
+ */
+typedef struct {
+    const char* name;       /**< Anzeigename. */
+    uint8_t instruction;    /**< HD44780-Befehl (RS = 0). */
+    uint16_t datasheet_us;  /**< Ausfuehrungszeit laut Datenblatt. */
+} lcd_benchmark_command;
+
+static const lcd_benchmark_command commands[] = {
+    {"Clear Display", 0x01, 1520},
+    {"Return Home",   0x02, 1520},
+    {"Entry Mode",    0x06, 37},
+    {"Display On",    0x0C, 37},
+    {"Set DDRAM",     0x80, 37},
+};
+
+/**
+ * @brief Misst die Zeit vom Senden eines Befehls bis das Busy-Flag geloescht ist.
+ *
+ * @param instruction Der HD44780-Befehl.
+ * @return Gemessene Zeit in Mikrosekunden.
+ */
+static uint16_t measure_instruction(uint8_t instruction) {
+    uint8_t value = 0;
+    uint32_t cycles = 0;
+
+    lcd_command(instruction);
+    uint16_t start = cycle_counter_now();
+
+    do {
+        lcd_readStatus(&value);
+        uint16_t now = cycle_counter_now();
+        cycles += static_cast<uint16_t>(now - start);
+        start = now;
+    } while ((value & 0x80) != 0 && cycles < F_CPU / 100); // Abbruch nach 10ms
+
+    return cycle_counter_to_us(cycles);
+}
+
+/**
+ * @brief Misst alle Befehle nacheinander und zeigt das Ergebnis an.
+ *
+ * @details
+ * Zeile 1: Name des Befehls, Zeile 2: gemessene Zeit / Datenblattwert in us.
+ */
+void lcd_latency_benchmark() {
+    char buf[12];
+
+    cycle_counter_init();
+
+    while (true) { // Use true instead of 1 for C++
+        for (uint8_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+            uint16_t measured = measure_instruction(commands[i].instruction);
+
+            lcd_clear(); // Anzeige nach Clear / Home wieder in einen bekannten Zustand bringen
+            lcd_bufferClear();
+            lcd_bufferPutString(0, 0, commands[i].name);
+            lcd_bufferPutString(0, 1, integer_to_string(buf, measured, 10));
+            lcd_bufferPutString(5, 1, "/");
+            lcd_bufferPutString(6, 1, integer_to_string(buf, commands[i].datasheet_us, 10));
+            lcd_bufferPutString(11, 1, "us");
+            lcd_flush();
+
+            _delay_ms(4 * WAIT);
+        }
+    }
+}
+
+/**
+ * @brief Hauptfunktion zur Initialisierung und Start der Messung.
+ *
+ * @return 0 bei erfolgreichem Abschluss.
+ */
+/*
+int main() {
+    lcd_init();
+    lcd_setWaitMode(LCD_WAIT_BUSY_FLAG); // lcd_clear() wartet nur so lange wie noetig
+
+    lcd_latency_benchmark();
+
+    return 0;
+}
+*/
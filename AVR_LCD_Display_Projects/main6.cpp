@@ -0,0 +1,62 @@
+/**
+ * @file main6.c
+ * @brief Zwei Displays an einem I2C-Bus.
+ *
+ * @details
+ * Ein 16x2-Display (Adresse 0x27) und ein 20x4-Display (Adresse 0x26, A0 am HW-061 gebrueckt) 
+ * zeigen denselben Zaehler in unterschiedlicher Darstellung. Beide Bildschirmpuffer werden 
+ * mit lcd_flushAll() gesendet: die I2C-Transaktionen der Displays wechseln sich in der 
+ * Warteschlange des Busses ab, statt nacheinander gesendet zu werden.
+ *
+ * @date 16. Oktober 2026
+ */
+
+#include "main.h"
+
+#define SECOND_DISPLAY_ADDRESS 0x26 /**< PCF8574 des 20x4-Displays. */
+
+static lcd_display small_display; /**< 16x2-Display. */
+static lcd_display large_display; /**< 20x4-Display. */
+
+/**
+ * @brief Zaehlt auf zwei Displays gleichzeitig.
+ *
+ * @details
+ * Das 16x2-Display zeigt die Zahl dezimal, das 20x4-Display dezimal, binaer und als Balken. 
+ * Gezeichnet wird jeweils in den Puffer des mit lcd_select() gewaehlten Displays.
+ */
+void dual_display_count() {
+    char buf[20];
+
+    lcd_setup(&small_display, 0x27, LCD_16X2);
+    lcd_setup(&large_display, SECOND_DISPLAY_ADDRESS, LCD_20X4);
+
+    lcd_select(&small_display);
+    lcd_init();
+    lcd_select(&large_display);
+    lcd_init();
+
+    for (int32_t counter = 0; counter <= 255; counter++) {
+        lcd_select(&small_display);
+        lcd_bufferClear();
+        lcd_bufferPutString(0, 0, integer_to_string(buf, counter, 10));
+
+        lcd_select(&large_display);
+        lcd_bufferClear();
+        lcd_bufferPutString(0, 0, "Dez:");
+        lcd_bufferPutString(5, 0, integer_to_string(buf, counter, 10));
+        lcd_bufferPutString(0, 1, "Bin:");
+        lcd_bufferPutString(5, 1, integer_to_string(buf, counter, 2));
+        lcd_bufferPutBar(0, 3, lcd_columns(), static_cast<uint16_t>(counter), 255);
+
+        lcd_flushAll();
+        _delay_ms(WAIT);
+    }
+}
+
+/*
+int main() { // Changed from main(void) to int main()
+    dual_display_count();
+    return 0;
+}
+*/
@@ -0,0 +1,114 @@
+/**
+ * @file main7.c
+ * @brief Zyklenmessung der Ganzzahl-Umwandlung: bisherige Routine gegen Int_Format.
+ *
+ * @details
+ * Die bisherige integer_to_string()-Kopie der Beispiele teilt in jeder Ziffer durch eine
+ * Basis, die erst zur Laufzeit bekannt ist. Der AVR hat keinen Dividierer, jede Ziffer kostet
+ * daher einen Aufruf der 32-Bit-Division der Bibliothek. Das Int_Format-Modul kommt ohne
+ * Division aus. Beide werden fuer Zahlen unterschiedlicher Laenge mit dem Cycle_Counter
+ * (TCB2) gemessen und auf dem LCD angezeigt.
+ *
+ * @date 16. Oktober 2026
+ */
+
+#include "main.h"
+#include "Cycle_Counter.h"
+
+static const int32_t benchmark_values[] = {7, 1234, 65535, 1000000, -2147483647}; /**< Gemessene Zahlen. */
+
+/**
+ * @brief Bisherige Umwandlung der Beispiele (Referenz fuer die Messung).
+ *
+ * @param buf Puffer zur Speicherung der Zeichenkette.
+ * @param num Die zu konvertierende Ganzzahl.
+ * @param base Das Zahlensystem.
+ * @return Ein Zeiger auf den resultierenden Puffer.
+ */
+static char* legacy_integer_to_string(char *buf, int32_t num, int base) {
+    bool isNegative = false;
+    int digitCounter = 0;
+
+    if (num == 0) {
+        buf[digitCounter++] = '0';
+    }
+
+    if (num < 0) {
+        isNegative = true;
+        num = static_cast<int32_t>(~num + 1);
+    }
+
+    while (num > 0) {
+        buf[digitCounter++] = static_cast<char>('0' + num % base);
+        num /= base;
+    }
+
+    if (isNegative) {
+        buf[digitCounter++] = '-';
+    }
+
+    buf[digitCounter] = '\0';
+
+    for (int i = 0, j = digitCounter - 1; i < j; i++, j--) {
+        char temp = buf[i];
+        buf[i] = buf[j];
+        buf[j] = temp;
+    }
+
+    return buf;
+}
+
+/**
+ * @brief Misst beide Routinen fuer jede Zahl und zeigt das Ergebnis an.
+ *
+ * @details
+ * Zeile 1: die Zahl, Zeile 2: Zyklen bisher / Zyklen mit Int_Format.
+ * Die Basis wird ueber eine volatile Variable uebergeben, damit der Compiler die
+ * bisherige Routine nicht auf eine konstante Basis 10 optimiert.
+ */
+void int_format_benchmark() {
+    char buf[INT_FORMAT_SIZE];
+    char text[INT_FORMAT_SIZE];
+    volatile int base = 10;
+
+    cycle_counter_init();
+
+    while (true) { // Use true instead of 1 for C++
+        for (uint8_t i = 0; i < sizeof(benchmark_values) / sizeof(benchmark_values[0]); i++) {
+            uint16_t start = cycle_counter_now();
+            legacy_integer_to_string(buf, benchmark_values[i], base);
+            uint16_t legacy_cycles = cycle_counter_elapsed(start);
+
+            start = cycle_counter_now();
+            integer_to_string(buf, benchmark_values[i], base);
+            uint16_t cycles = cycle_counter_elapsed(start);
+
+            lcd_bufferClear();
+            lcd_bufferPutString(0, 0, buf);
+            int_format_right(text, legacy_cycles, 5, ' ');
+            lcd_bufferPutString(0, 1, text);
+            lcd_bufferPutString(6, 1, "/");
+            int_format_right(text, cycles, 5, ' ');
+            lcd_bufferPutString(8, 1, text);
+            lcd_bufferPutString(14, 1, "cy");
+            lcd_flush();
+
+            _delay_ms(4 * WAIT);
+        }
+    }
+}
+
+/**
+ * @brief Hauptfunktion zur Initialisierung und Start der Messung.
+ *
+ * @return 0 bei erfolgreichem Abschluss.
+ */
+/*
+int main() {
+    lcd_init();
+
+    int_format_benchmark();
+
+    return 0;
+}
+*/
@@ -22,6 +22,7 @@
 #include <util/delay.h>
 #include <cstdio> // Changed from <stdio.h> for C++
 #include "I2C_LCD.h"
+#include "Int_Format.h" // integer_to_string()
 
 /** @brief RGB-LED-Pins. */
 #define LED_PINS (PIN0_bm | PIN1_bm | PIN2_bm)
@@ -41,7 +42,7 @@
 #define GREEN 2
 #define YELLOW_TO_RED 3
 
-/** @brief Funktionsprototyp fr die Ganzzahl-zu-String-Konvertierung. */
-char* integer_to_string(char *buf, int32_t num, int base); // Removed void from parameter list for C++
+/** @brief LCD-Ereignis: angezeigte Zeit hat sich geaendert (siehe lcd_post()). */
+#define EVENT_TIME 0x01
 
 #endif
\ No newline at end of file
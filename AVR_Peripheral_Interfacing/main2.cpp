@@ -21,64 +21,38 @@ char buf[32];
 /**
  * @brief Zhler fr vergangene Sekunden.
  */
-uint16_t number = 0;
+volatile uint16_t number = 0;
 
 /**
- * @brief Konvertiert eine Ganzzahl in eine Zeichenkette.
+ * @brief Zeichnet den Sekundenzhler in den Bildschirmpuffer.
  * 
- * Diese Funktion wandelt eine Ganzzahl (`int32_t`) in eine Zeichenkette 
- * (`char*`) um und untersttzt verschiedene Basen (z. B. Dezimal, Hexadezimal).
+ * Wird von lcd_service() in der Hauptschleife aufgerufen, danach werden 
+ * die geaenderten Zeichen gesendet.
  * 
- * @param buf Zeiger auf den Zeichenpuffer fr die Ausgabe.
- * @param num Die zu konvertierende Zahl.
- * @param base Die Basis des Zahlensystems (z. B. 10 fr Dezimal).
- * @return Zeiger auf den Zeichenpuffer mit der konvertierten Zeichenkette.
+ * @param events Seit dem letzten Aufruf gemeldete Ereignisse.
  */
-char* integer_to_string(char *buf, int32_t num, int base) {
-    bool isNegative = false;
-    int digitCounter = 0;
+void render_lcd(uint8_t events) {
+    if (!(events & EVENT_TIME))
+        return; // Nichts Angezeigtes hat sich geaendert
 
-    if (num == 0) {
-        buf[digitCounter++] = '0';
-    }
-
-    if (num < 0) {
-        isNegative = true;
-        num = static_cast<int32_t>(~num + 1); // Zweierkomplement, C++ style cast
-    }
-
-    while (num > 0) {
-        buf[digitCounter++] = static_cast<char>('0' + num % base); // C++ style cast
-        num /= base;
-    }
-
-    if (isNegative) {
-        buf[digitCounter++] = '-';
-    }
-
-    buf[digitCounter] = '\0';
-
-    // Zeichenkette umkehren
-    for (int i = 0, j = digitCounter - 1; i < j; i++, j--) {
-        char temp = buf[i];
-        buf[i] = buf[j];
-        buf[j] = temp;
-    }
+    cli(); // 16-Bit-Wert wird von der ISR geschrieben
+    uint16_t seconds = number;
+    sei();
 
-    return buf;
+    lcd_bufferClear();
+    lcd_bufferPutString(0, 0, integer_to_string(buf, seconds, 10));
 }
 
 /**
  * @brief Interrupt-Service-Routine fr den Timer Overflow (TCA0).
  * 
  * Diese ISR wird ausgelst, wenn der Timer TCA0 einen Overflow erreicht. 
- * Der Sekundenzhler wird inkrementiert und die neue Zeit auf dem LCD angezeigt.
+ * Der Sekundenzhler wird inkrementiert und ein LCD-Ereignis gemeldet; 
+ * die ISR selbst greift nicht auf den I2C-Bus zu.
  */
 ISR(TCA0_OVF_vect) {
     number++;              
-    lcd_clear();           
-    lcd_putString(integer_to_string(buf, number, 10)); 
-    lcd_moveCursor(0, 0);  
+    lcd_post(EVENT_TIME);
     // TCA0_OVF-Flag wird automatisch gelscht
 }
 
@@ -94,6 +68,7 @@ ISR(TCA0_OVF_vect) {
 
 int main() { // Changed from main(void) to int main()
     lcd_init(); 
+    lcd_setRenderer(render_lcd);
     
     // Konfiguration des Timers
     TCA0.SINGLE.INTCTRL = TCA_SINGLE_OVF_bm; 
@@ -103,7 +78,7 @@ int main() { // Changed from main(void) to int main()
     sei(); 
 
     while (true) { // Use true instead of 1 for C++
-        // Wartet passiv auf Timer-Interrupts
+        lcd_service(); // Zeichnet die von der ISR gemeldeten Ereignisse
     }
     return 0; // Added return 0 for int main()
 }
@@ -30,61 +30,32 @@ volatile uint8_t timer_running = 0;
 char buf[32];
 
 /**
- * @brief Konvertiert eine Ganzzahl in eine Zeichenkette.
- * 
- * Diese Funktion wandelt eine Ganzzahl (`int32_t`) in eine Zeichenkette 
- * (`char*`) um und untersttzt verschiedene Basen (z. B. Dezimal, Hexadezimal).
+ * @brief LCD anzeigen aktualisieren.
  * 
- * @param buf Zeiger auf den Zeichenpuffer fr die Ausgabe.
- * @param num Die zu konvertierende Zahl.
- * @param base Die Basis des Zahlensystems (z. B. 10 fr Dezimal).
- * @return Zeiger auf den Zeichenpuffer mit der konvertierten Zeichenkette.
+ * Meldet nur ein Ereignis und kann daher aus einer ISR aufgerufen werden; 
+ * gezeichnet wird in der Hauptschleife (siehe render_lcd()).
  */
-char* integer_to_string(char *buf, int32_t num, int base) {
-    bool isNegative = false;
-    int digitCounter = 0;
-
-    if (num == 0) {
-        buf[digitCounter++] = '0';
-    }
-
-    if (num < 0) {
-        isNegative = true;
-        num = static_cast<int32_t>(~num + 1); // Zweierkomplement, C++ style cast
-    }
-
-    while (num > 0) {
-        buf[digitCounter++] = static_cast<char>('0' + num % base); // Cast to char
-        num /= base;
-    }
-
-    if (isNegative) {
-        buf[digitCounter++] = '-';
-    }
-
-    buf[digitCounter] = '\0';
-
-    // Zeichenkette umkehren
-    for (int i = 0, j = digitCounter - 1; i < j; i++, j--) {
-        char temp = buf[i];
-        buf[i] = buf[j];
-        buf[j] = temp;
-    }
-
-    return buf;
+void update_lcd() {
+    lcd_post(EVENT_TIME);
 }
 
-
 /**
- * @brief LCD anzeigen aktualisieren.
+ * @brief Zeichnet die verbleibende Zeit in Sekunden in den Bildschirmpuffer.
+ * 
+ * Wird von lcd_service() aufgerufen, es werden nur die geaenderten Ziffern gesendet.
  * 
- * Diese Funktion lscht den LCD-Bildschirm und zeigt die verbleibende Zeit 
- * in Sekunden an.
+ * @param events Seit dem letzten Aufruf gemeldete Ereignisse.
  */
-void update_lcd() {
-    lcd_clear();
-    lcd_putString(integer_to_string(buf, remaining_time, 10)); 
-    lcd_moveCursor(0, 0);
+void render_lcd(uint8_t events) {
+    if (!(events & EVENT_TIME))
+        return; // Nichts Angezeigtes hat sich geaendert
+
+    cli(); // 16-Bit-Wert wird von den ISRs geschrieben
+    uint16_t time = remaining_time;
+    sei();
+
+    lcd_bufferClear();
+    lcd_bufferPutString(0, 0, integer_to_string(buf, time, 10)); 
 }
 
 /**
@@ -143,6 +114,7 @@ ISR(PORTC_PORT_vect) {
  */
 int main() { // Changed from main(void) to int main()
     lcd_init();
+    lcd_setRenderer(render_lcd);
 
     PORTE.DIRSET = LED_PINS; 
     PORTE.OUTCLR = LED_PINS; 
@@ -158,7 +130,7 @@ int main() { // Changed from main(void) to int main()
     update_lcd();
 
     while (true) { // Use true instead of 1 for C++
-        // Endlosschleife, keine Aktionen erforderlich
+        lcd_service(); // Zeichnet die von den ISRs gemeldeten Ereignisse
     }
     return 0; // Added return 0 for int main()
 }
@@ -0,0 +1,90 @@
+/*
+ ***********************************************************************************
+ * @file:   ADC_Scale.cpp
+ * @date:   16.10.2026
+ *
+ * This module converts ADC results to physical values and text in fixed point
+ * (see ADC_Scale.h).
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+ */
+
+// INCLUDES //
+#include "ADC_Scale.h"
+#include "Int_Format.h"
+
+// PUBLIC FUNCTIONS //
+/*
+*	Sets the scale of a channel from the datasheet formula value = RES * full_scale / 2^resolution.
+*
+*	@param scale Scale of the channel
+*	@param full_scale Value of 2^resolution counts in the output unit (e.g. 330 for VREF = 3.30V in 10mV)
+*	@param resolution Bits of the ADC result (12, up to 16 with accumulation)
+*	@param decimals Decimal places of the output unit (0 - 9)
+*	@param unit Appended to the text ('\0': none)
+*	@return None
+*/
+void adc_scale_setup(adc_channel_scale* scale, uint16_t full_scale, uint8_t resolution, uint8_t decimals, char unit) {
+	if (resolution > 16)
+		resolution = 16;
+
+	scale->factor = static_cast<uint32_t>(full_scale) << (16 - resolution);	// Exact, no rounding
+	scale->offset = 0;
+	scale->decimals = decimals;
+	scale->unit = unit;
+}
+
+/*
+*	Replaces the scale by a measured calibration.
+*
+*	@param scale Scale of the channel
+*	@param factor Output units per ADC count in Q16 (count * factor must fit into 32 bits)
+*	@param offset Added after scaling (output units)
+*	@return None
+*/
+void adc_scale_calibrate(adc_channel_scale* scale, uint32_t factor, int32_t offset) {
+	scale->factor = factor;
+	scale->offset = offset;
+}
+
+/*
+*	Text of a scaled value with decimal point and unit, e.g. 5 with 2 decimals -> "0.05V".
+*	Only shifts the digits, no division.
+*
+*	@param scale Scale of the channel (decimals and unit)
+*	@param value Value in the output unit
+*	@param buf At least ADC_SCALE_TEXT_SIZE characters
+*	@return uint8_t Number of characters (without '\0')
+*/
+uint8_t adc_scale_format(const adc_channel_scale* scale, int32_t value, char* buf) {
+	char digits[12];
+	char* out = buf;
+	uint32_t magnitude = static_cast<uint32_t>(value);
+
+	if (value < 0) {
+		*out++ = '-';
+		magnitude = 0UL - magnitude;
+	}
+
+	// At least one digit left of the decimal point: 5 -> "0.05" for 2 decimals //
+	uint8_t length = int_format_unsigned(digits, magnitude);
+	uint8_t width = (length > scale->decimals) ? length : static_cast<uint8_t>(scale->decimals + 1);
+	uint8_t zeros = static_cast<uint8_t>(width - length);
+
+	for (uint8_t i = 0; i < width; i++) {
+		if (scale->decimals != 0 && i == width - scale->decimals)
+			*out++ = '.';
+		*out++ = (i < zeros) ? '0' : digits[i - zeros];
+	}
+
+	if (scale->unit != '\0')
+		*out++ = scale->unit;
+	*out = '\0';
+
+	return static_cast<uint8_t>(out - buf);
+}
@@ -0,0 +1,68 @@
+/*
+ ***********************************************************************************
+ * @file:   ADC_Scale.h
+ * @date:   16.10.2026
+ *
+ * This module converts ADC results to physical values and text in fixed point, so no
+ * soft-float code is needed (the AVR has no FPU).
+ * Every channel has its own scale: the value of the full ADC range in an integer output
+ * unit (e.g. 330 for 3.30V in units of 10mV, 1000 for 100.0% in units of 0.1%) and the
+ * number of decimal places of that unit.
+ *
+ * The scale is stored as factor in Q16 (output units per ADC count * 65536):
+ *   value = (count * factor + 0x8000) >> 16
+ * For the datasheet formula V = RES * VREF / 2^n the factor is exact, so every result
+ * is rounded correctly (half up). Other factors (e.g. a measured calibration) are
+ * rounded to 1/65536 of an output unit.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Usage:
+  adc_channel_scale voltage;
+  adc_scale_setup(&voltage, 330, 12, 2, 'V');       // 12-Bit result, 3.30V full scale
+  int32_t value = adc_scale_apply(&voltage, ADC0.RES);
+  adc_scale_format(&voltage, value, buf);           // e.g. "1.65V"
+*/
+
+
+#ifndef ADC_SCALE_H_
+#define ADC_SCALE_H_
+
+// INCLUDES //
+#include <stdint.h>
+
+// DEFINES //
+#define ADC_SCALE_TEXT_SIZE	14		// Largest text: '-', 10 digits, '.', unit, '\0'
+
+// TYPES //
+typedef struct {
+	uint32_t	factor;		// Output units per ADC count in Q16
+	int32_t		offset;		// Added after scaling (output units)
+	uint8_t		decimals;	// Decimal places of the output unit (2: 330 is shown as 3.30)
+	char		unit;		// Appended to the text ('\0': none)
+} adc_channel_scale;
+
+// FUNCTION DECLARATIONS //
+void adc_scale_setup(adc_channel_scale* scale, uint16_t full_scale, uint8_t resolution, uint8_t decimals, char unit);
+
+void adc_scale_calibrate(adc_channel_scale* scale, uint32_t factor, int32_t offset);
+
+uint8_t adc_scale_format(const adc_channel_scale* scale, int32_t value, char* buf);
+
+/*
+*	Scales an ADC result (Q16 multiply, rounded half up).
+*
+*	@param scale Scale of the channel
+*	@param count ADC result (up to 16 bits with accumulation)
+*	@return int32_t Value in the output unit of the channel
+*/
+static inline int32_t adc_scale_apply(const adc_channel_scale* scale, uint16_t count) {
+	return static_cast<int32_t>((count * scale->factor + 0x8000UL) >> 16) + scale->offset;
+}
+
+#endif /* ADC_SCALE_H_ */
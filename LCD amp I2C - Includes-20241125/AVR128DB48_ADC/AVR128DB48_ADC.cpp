@@ -0,0 +1,594 @@
+/*
+ ***********************************************************************************
+ * @file:   AVR128DB48_ADC.cpp
+ * @date:   16.10.2026
+ *
+ * This module runs ADC0 in free-running mode, paced by TCB0 or as a scan of several inputs
+ * and collects the results in ring buffers from the RESRDY interrupt. In notify mode the
+ * window comparator reports only changes (see AVR128DB48_ADC.h).
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+ */
+
+// INCLUDES //
+#include "AVR128DB48_ADC.h"
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#ifndef F_CPU
+#define F_CPU 4000000
+#endif
+
+// DEFINES //
+#define ADC_BITS			12		// Resolution of one conversion
+#define ADC_SAMPLE_CLOCKS	(2 + ADC_SAMPLE_LENGTH + 13)	// CLK_ADC per conversion (sampling + 12-bit conversion)
+#define ADC_MAX_SUM_SHIFT	4		// RES holds sums of up to 16 samples, above that its upper 16 bits
+
+#define ADC_TIMER			TCB0						// Trigger timer of adc_startTimed()
+#define ADC_TIMER_EVENT		EVSYS_CHANNEL0_TCB0_CAPT_gc	// Its event generator on channel 0
+
+/*
+*	PRESC setting of a clock divider (AVR128DB48 Data sheet -> ADC -> CTRLC).
+*	Only the powers of two are offered, so adc_resultRate() stays a shift.
+*/
+static constexpr uint8_t prescaler_setting(uint16_t div) {
+	return (div == 2) ? ADC_PRESC_DIV2_gc
+		: (div == 4) ? ADC_PRESC_DIV4_gc
+		: (div == 8) ? ADC_PRESC_DIV8_gc
+		: (div == 16) ? ADC_PRESC_DIV16_gc
+		: (div == 32) ? ADC_PRESC_DIV32_gc
+		: (div == 64) ? ADC_PRESC_DIV64_gc
+		: (div == 128) ? ADC_PRESC_DIV128_gc
+		: (div == 256) ? ADC_PRESC_DIV256_gc
+		: 0xFF;
+}
+
+static_assert(prescaler_setting(ADC_CLOCK_DIV) != 0xFF, "ADC_CLOCK_DIV must be a power of two from 2 to 256");
+static_assert((ADC_RING_SIZE & (ADC_RING_SIZE - 1)) == 0, "ADC_RING_SIZE must be a power of two");
+static_assert(ADC_RING_SIZE <= 128, "ADC_RING_SIZE must fit into the 8-bit ring indices");
+static_assert((ADC_SCAN_RING_SIZE & (ADC_SCAN_RING_SIZE - 1)) == 0, "ADC_SCAN_RING_SIZE must be a power of two");
+static_assert(ADC_SCAN_RING_SIZE <= 128, "ADC_SCAN_RING_SIZE must fit into the 8-bit ring indices");
+
+// TYPES //
+// Ring of one scanned input, same rules as the free-running ring //
+typedef struct {
+	adc_sample samples[ADC_SCAN_RING_SIZE];
+	uint8_t head;		// Only written by the interrupt
+	uint8_t tail;		// Only written by adc_readScan()
+} scan_ring;
+
+// VARIABLES //
+static volatile uint16_t	ring[ADC_RING_SIZE];	// Samples, oldest at ring_tail
+static volatile uint8_t		ring_head = 0;			// Next free slot, only written by the interrupt
+static volatile uint8_t		ring_tail = 0;			// Oldest sample, only written by adc_readSamples()
+static volatile uint16_t	overflows = 0;			// Samples dropped because the ring was full
+static volatile scan_ring	scan_rings[ADC_SCAN_CHANNELS];
+static uint8_t				scan_muxpos[ADC_SCAN_CHANNELS];	// Inputs in scan order
+static volatile uint8_t		scan_channels = 0;		// Inputs in the running scan (0: no scan)
+static volatile uint8_t		scan_index = 0;			// Input of the conversion in progress
+static volatile bool		timed = false;			// Conversions are started by ADC_TIMER
+static volatile adc_timing	timing_stats;			// Latency of the RESRDY interrupt in timed mode
+static uint16_t				notify_deadband = 0;	// Half width of the window in RES units
+static volatile uint16_t	notify_value = 0;		// Last reported result (RES units)
+static volatile bool		notify_changed = false;	// notify_value not yet taken by the application
+static uint16_t				time_high = 0;			// Upper 16 bits of the RTC time (wraps of RTC.CNT)
+static uint16_t				time_last = 0;			// RTC.CNT at the previous result, detects the wrap
+static uint8_t				accumulation_log2 = 0;	// Samples per result = 2^accumulation_log2
+static uint8_t				result_bits = 12;		// Resolution of the results
+static int8_t				result_shift = 0;		// RES -> result: left shift (> 0) or right shift (< 0)
+
+
+// PRIVATE FUNCTIONS //
+/*
+*	Result in the selected resolution from the RES register (see adc_setOversampling()).
+*/
+static inline uint16_t scale_result(uint16_t res) {
+	return (result_shift >= 0) ? static_cast<uint16_t>(res << result_shift) : static_cast<uint16_t>(res >> -result_shift);
+}
+
+/*
+*	Inverse of scale_result() for distances (the window compares RES, not the result).
+*/
+static inline uint16_t unscale_result(uint16_t result) {
+	return (result_shift >= 0) ? static_cast<uint16_t>(result >> result_shift) : static_cast<uint16_t>(result << -result_shift);
+}
+
+
+// PUBLIC FUNCTIONS //
+/*
+*	Initializes ADC0: VDD as reference, 12-bit results without oversampling,
+*	ADC_CLOCK_DIV and ADC_SAMPLE_LENGTH.
+*
+*	@param None
+*	@return None
+*/
+void adc_init() {
+	VREF.ADC0REF = VREF_REFSEL_VDD_gc;
+	ADC0.CTRLC = prescaler_setting(ADC_CLOCK_DIV);
+	ADC0.SAMPCTRL = ADC_SAMPLE_LENGTH;
+	ADC0.CTRLA = ADC_ENABLE_bm | ADC_RESSEL_12BIT_gc;	// RESSEL is in CTRLA, CTRLB only holds SAMPNUM
+	adc_setOversampling(ADC_SAMPNUM_NONE_gc, ADC_BITS);
+}
+
+/*
+*	Starts continuous conversions of one input. Samples from an earlier run are discarded.
+*	The samples arrive once the global interrupts are enabled.
+*
+*	@param muxpos Input channel, e.g. ADC_MUXPOS_AIN18_gc
+*	@return None
+*/
+void adc_startFreeRunning(uint8_t muxpos) {
+	adc_stop();
+
+	ring_head = 0;
+	ring_tail = 0;
+	overflows = 0;
+
+	ADC0.MUXPOS = muxpos;
+	ADC0.INTFLAGS = ADC_RESRDY_bm;
+	ADC0.INTCTRL = ADC_RESRDY_bm;
+	ADC0.CTRLA |= ADC_FREERUN_bm;
+	ADC0.COMMAND = ADC_STCONV_bm;	// First conversion, the next ones start by themselves
+}
+
+/*
+*	Stops the conversions of every mode. Samples in the rings can still be read.
+*
+*	@param None
+*	@return None
+*/
+void adc_stop() {
+	scan_channels = 0;	// The interrupt does not start another conversion
+	if (timed) {		// ADC_TIMER and the event channel are only touched if timed mode owns them
+		ADC_TIMER.CTRLA = 0;
+		EVSYS.USERADC0START = 0;
+		EVSYS.CHANNEL0 = 0;
+		timed = false;
+	}
+	ADC0.EVCTRL = 0;
+	ADC0.CTRLE = ADC_WINCM_NONE_gc;
+	ADC0.CTRLA &= static_cast<uint8_t>(~ADC_FREERUN_bm);
+	ADC0.COMMAND = ADC_SPCONV_bm;
+	ADC0.INTCTRL = 0;
+	ADC0.INTFLAGS = ADC_RESRDY_bm | ADC_WCMP_bm;
+}
+
+/*
+*	Measures one input by polling (only while the ADC is not free-running).
+*
+*	@param muxpos Input channel, e.g. ADC_MUXPOS_AIN19_gc
+*	@return uint16_t Result in adc_resolution() bits
+*/
+uint16_t adc_read(uint8_t muxpos) {
+	ADC0.MUXPOS = muxpos;
+	ADC0.COMMAND = ADC_STCONV_bm;
+	while (!(ADC0.INTFLAGS & ADC_RESRDY_bm));
+	ADC0.INTFLAGS = ADC_RESRDY_bm;
+	return scale_result(ADC0.RES);
+}
+
+/*
+*	Number of samples waiting in the ring.
+*
+*	@param None
+*	@return uint8_t 0 ... ADC_RING_SIZE - 1
+*/
+uint8_t adc_available() {
+	return static_cast<uint8_t>((ring_head - ring_tail) & (ADC_RING_SIZE - 1));
+}
+
+/*
+*	Takes the oldest samples out of the ring (does not wait).
+*
+*	@param samples Destination, oldest sample first (in adc_resolution() bits)
+*	@param max Size of samples
+*	@return uint8_t Number of samples copied (0 if the ring is empty)
+*/
+uint8_t adc_readSamples(uint16_t* samples, uint8_t max) {
+	uint8_t head = ring_head;	// Samples written after this are left for the next call
+	uint8_t tail = ring_tail;
+	uint8_t count = 0;
+
+	while (tail != head && count < max) {
+		samples[count++] = scale_result(ring[tail]);	// Shift here, the interrupt stays short
+		tail = (tail + 1) & (ADC_RING_SIZE - 1);
+	}
+
+	ring_tail = tail;	// Frees the slots only after they were copied
+	return count;
+}
+
+/*
+*	Number of samples dropped since the last start because a ring was full.
+*	If it grows, take the batches out more often or increase ADC_RING_SIZE / ADC_SCAN_RING_SIZE.
+*
+*	@param None
+*	@return uint16_t Dropped samples (stops at 65535)
+*/
+uint16_t adc_overflows() {
+	uint8_t sreg = SREG;	// 16-bit value is written by the interrupt
+	cli();
+	uint16_t count = overflows;
+	SREG = sreg;
+	return count;
+}
+
+/*
+*	Selects how many samples the ADC adds up per result and the resolution of the results.
+*	Only while the ADC is not free-running (adc_startFreeRunning() / adc_stop()).
+*
+*	Every result is the mean of the samples as a fixed-point number:
+*	result = mean * 2^(resolution - 12), e.g. 16 samples and 14 bit -> 0 ... 16380 in 1/4 LSB.
+*	Noise drops with the square root of the number of samples (see AVR128DB48_ADC.h),
+*	the results per second drop with the number of samples (adc_resultRate()).
+*
+*	@param accumulation Samples per result, ADC_SAMPNUM_NONE_gc ... ADC_SAMPNUM_ACC128_gc
+*	@param resolution Bits of the results (12 ... 16, more than adc_effectiveBits() only adds steps)
+*	@return bool false if the parameters are out of range (setting unchanged)
+*/
+bool adc_setOversampling(uint8_t accumulation, uint8_t resolution) {
+	if (accumulation > ADC_SAMPNUM_ACC128_gc || resolution < ADC_BITS || resolution > 16)
+		return false;
+
+	// SAMPNUM is log2 of the samples, RES holds the sum (without the lower bits above 16 samples) //
+	uint8_t dropped = (accumulation > ADC_MAX_SUM_SHIFT) ? static_cast<uint8_t>(accumulation - ADC_MAX_SUM_SHIFT) : 0;
+
+	accumulation_log2 = accumulation;
+	result_bits = resolution;
+	result_shift = static_cast<int8_t>(resolution - ADC_BITS - accumulation + dropped);
+	ADC0.CTRLB = accumulation;
+	return true;
+}
+
+/*
+*	Bits of the results (as selected with adc_setOversampling()), e.g. for adc_scale_setup().
+*
+*	@param None
+*	@return uint8_t 12 ... 16
+*/
+uint8_t adc_resolution() {
+	return result_bits;
+}
+
+/*
+*	Bits that are above the noise: 4 times the samples halve white noise,
+*	i.e. one more bit per factor 4.
+*
+*	@param None
+*	@return uint8_t 12 ... 15
+*/
+uint8_t adc_effectiveBits() {
+	return static_cast<uint8_t>(ADC_BITS + accumulation_log2 / 2);
+}
+
+/*
+*	Results per second with the current oversampling (free-running, estimated from
+*	the conversion time, see AVR128DB48_ADC.h).
+*
+*	@param None
+*	@return uint16_t Results per second
+*/
+uint16_t adc_resultRate() {
+	return static_cast<uint16_t>((F_CPU / ADC_CLOCK_DIV / ADC_SAMPLE_CLOCKS) >> accumulation_log2);
+}
+
+/*
+*	Starts converting the inputs one after another (round robin), each result goes into
+*	the ring of its input. Samples from an earlier run are discarded.
+*	Oversampling (adc_setOversampling()) applies to every input.
+*
+*	@param muxpos Inputs in scan order, e.g. {ADC_MUXPOS_AIN19_gc, ADC_MUXPOS_AIN18_gc}
+*	@param channels Number of inputs (1 ... ADC_SCAN_CHANNELS)
+*	@return bool false if channels is out of range (nothing started)
+*/
+bool adc_startScan(const uint8_t* muxpos, uint8_t channels) {
+	if (channels == 0 || channels > ADC_SCAN_CHANNELS)
+		return false;
+
+	adc_stop();
+
+	// Time base: RTC counts the 32.768kHz oscillator over the full 16 bits //
+	if (!(RTC.CTRLA & RTC_RTCEN_bm)) {
+		while (RTC.STATUS != 0);
+		RTC.CLKSEL = RTC_CLKSEL_OSC32K_gc;
+		RTC.PER = 0xFFFF;
+		RTC.CTRLA = RTC_PRESCALER_DIV1_gc | RTC_RTCEN_bm;
+	}
+	time_high = 0;
+	time_last = RTC.CNT;
+
+	for (uint8_t i = 0; i < channels; i++) {
+		scan_muxpos[i] = muxpos[i];
+		scan_rings[i].head = 0;
+		scan_rings[i].tail = 0;
+	}
+	overflows = 0;
+	scan_index = 0;
+	scan_channels = channels;
+
+	ADC0.MUXPOS = scan_muxpos[0];
+	ADC0.INTFLAGS = ADC_RESRDY_bm;
+	ADC0.INTCTRL = ADC_RESRDY_bm;
+	ADC0.COMMAND = ADC_STCONV_bm;	// The interrupt starts the following conversions
+	return true;
+}
+
+/*
+*	Number of samples waiting in the ring of a scanned input.
+*
+*	@param channel Index of the input in the list of adc_startScan()
+*	@return uint8_t 0 ... ADC_SCAN_RING_SIZE - 1, 0 if channel is not part of the running scan
+*/
+uint8_t adc_scanAvailable(uint8_t channel) {
+	if (channel >= scan_channels)
+		return 0;
+	return static_cast<uint8_t>((scan_rings[channel].head - scan_rings[channel].tail) & (ADC_SCAN_RING_SIZE - 1));
+}
+
+/*
+*	Takes the oldest samples of a scanned input out of its ring (does not wait).
+*
+*	@param channel Index of the input in the list of adc_startScan()
+*	@param samples Destination, oldest sample first
+*	@param max Size of samples
+*	@return uint8_t Number of samples copied (0 if the ring is empty or channel is not part of the running scan)
+*/
+uint8_t adc_readScan(uint8_t channel, adc_sample* samples, uint8_t max) {
+	if (channel >= scan_channels)
+		return 0;
+
+	volatile scan_ring* ring = &scan_rings[channel];
+	uint8_t head = ring->head;
+	uint8_t tail = ring->tail;
+	uint8_t count = 0;
+
+	while (tail != head && count < max) {
+		samples[count].value = scale_result(ring->samples[tail].value);
+		samples[count].time = ring->samples[tail].time;
+		count++;
+		tail = (tail + 1) & (ADC_SCAN_RING_SIZE - 1);
+	}
+
+	ring->tail = tail;
+	return count;
+}
+
+/*
+*	Converts one input at a fixed rate: TCB0 runs with F_CPU (periodic interrupt mode, the
+*	interrupt itself stays off) and its CAPT event starts every conversion through EVSYS
+*	channel 0. The results go into the same ring as in free-running mode (adc_readSamples()).
+*	The rate is exact if F_CPU is a multiple of it, otherwise it is F_CPU / round(F_CPU / rate).
+*
+*	@param muxpos Input channel, e.g. ADC_MUXPOS_AIN18_gc
+*	@param rate Samples per second (one result per trigger, including oversampling)
+*	@return bool false if the rate is 0, slower than the timer allows (F_CPU / 2 / 65536)
+*	             or faster than one conversion (nothing started)
+*/
+bool adc_startTimed(uint8_t muxpos, uint16_t rate) {
+	if (rate == 0)
+		return false;
+
+	uint32_t cycles = (F_CPU + rate / 2) / rate;
+	uint32_t conversion = (static_cast<uint32_t>(ADC_CLOCK_DIV) * ADC_SAMPLE_CLOCKS) << accumulation_log2;
+	if (cycles <= conversion)
+		return false;
+
+	// 16-bit period: slow rates count with F_CPU / 2 //
+	uint8_t clock = TCB_CLKSEL_DIV1_gc;
+	if (cycles > 0x10000UL) {
+		cycles = (cycles + 1) / 2;
+		clock = TCB_CLKSEL_DIV2_gc;
+		if (cycles > 0x10000UL)
+			return false;
+	}
+
+	adc_stop();
+
+	ring_head = 0;
+	ring_tail = 0;
+	overflows = 0;
+	adc_readTiming(0, true);
+	timing_stats.period = static_cast<uint16_t>(cycles);
+
+	// Timer -> event channel -> ADC start, no CPU per sample //
+	ADC_TIMER.CCMP = static_cast<uint16_t>(cycles - 1);
+	ADC_TIMER.CNT = 0;
+	ADC_TIMER.CTRLB = TCB_CNTMODE_INT_gc;
+	EVSYS.CHANNEL0 = ADC_TIMER_EVENT;
+	EVSYS.USERADC0START = EVSYS_USER_CHANNEL0_gc;
+
+	ADC0.MUXPOS = muxpos;
+	ADC0.EVCTRL = ADC_STARTEI_bm;
+	ADC0.INTFLAGS = ADC_RESRDY_bm;
+	ADC0.INTCTRL = ADC_RESRDY_bm;
+	timed = true;
+
+	ADC_TIMER.CTRLA = clock | TCB_ENABLE_bm;
+	return true;
+}
+
+/*
+*	Copies the latency statistics of the timed conversions.
+*
+*	@param timing Destination (0: only reset)
+*	@param reset Start new statistics after the copy
+*	@return None
+*/
+void adc_readTiming(adc_timing* timing, bool reset) {
+	uint8_t sreg = SREG;	// Statistics are written by the interrupt
+	cli();
+
+	if (timing != 0) {
+		timing->results = timing_stats.results;
+		timing->latency_sum = timing_stats.latency_sum;
+		timing->latency_min = timing_stats.latency_min;
+		timing->latency_max = timing_stats.latency_max;
+		timing->period = timing_stats.period;
+	}
+
+	if (reset) {
+		timing_stats.results = 0;
+		timing_stats.latency_sum = 0;
+		timing_stats.latency_min = 0xFFFF;
+		timing_stats.latency_max = 0;
+	}
+
+	SREG = sreg;
+}
+
+/*
+*	Converts one input continuously and reports only changes (window comparator, WCMP interrupt).
+*	The first result is always reported. Oversampling (adc_setOversampling()) smooths the
+*	results before the comparison, the deadband then only has to cover the remaining noise.
+*
+*	@param muxpos Input channel, e.g. ADC_MUXPOS_AIN19_gc
+*	@param deadband Change that is ignored (in adc_resolution() bits, e.g. 8 for 14 bit = 2 LSB of 12 bit)
+*	@return None
+*/
+void adc_startNotify(uint8_t muxpos, uint16_t deadband) {
+	adc_stop();
+
+	notify_deadband = unscale_result(deadband);
+	notify_changed = false;
+
+	// Empty window: the first result is outside //
+	ADC0.WINLT = 0xFFFF;
+	ADC0.WINHT = 0;
+	ADC0.CTRLE = ADC_WINCM_OUTSIDE_gc;
+
+	ADC0.MUXPOS = muxpos;
+	ADC0.INTFLAGS = ADC_RESRDY_bm | ADC_WCMP_bm;
+	ADC0.INTCTRL = ADC_WCMP_bm;
+	ADC0.CTRLA |= ADC_FREERUN_bm;
+	ADC0.COMMAND = ADC_STCONV_bm;
+}
+
+/*
+*	Takes the value reported by the window comparator (does not wait).
+*
+*	@param value Destination of the new value (in adc_resolution() bits), unchanged if false
+*	@return bool true if the value moved beyond the deadband since the last call
+*/
+bool adc_changed(uint16_t* value) {
+	uint8_t sreg = SREG;	// 16-bit value is written by the interrupt
+	cli();
+
+	bool changed = notify_changed;
+	if (changed) {
+		*value = scale_result(notify_value);
+		notify_changed = false;
+	}
+
+	SREG = sreg;
+	return changed;
+}
+
+/*
+*	Sleeps (idle mode, the ADC keeps converting) until the value moves beyond the deadband.
+*	Other interrupts (e.g. I2C) wake the CPU briefly, it goes back to sleep afterwards.
+*	Needs global interrupts enabled.
+*
+*	@param None
+*	@return uint16_t New value (in adc_resolution() bits)
+*/
+uint16_t adc_waitChange() {
+	uint16_t value;
+
+	set_sleep_mode(SLEEP_MODE_IDLE);
+	while (true) { // Use true instead of 1 for C++
+		cli();
+		if (adc_changed(&value)) {
+			sei();
+			return value;
+		}
+
+		// sei takes effect after the next instruction: no interrupt between the test and sleep_cpu //
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+	}
+}
+
+
+// INTERRUPTS //
+/*
+*	Result ready: store it if there is room. RES is always read, this clears RESRDY.
+*	During a scan the next input is started first, so the conversions follow each other
+*	without waiting for the copy. In timed mode the timer still counts from the trigger,
+*	its value is the latency of this interrupt.
+*/
+ISR(ADC0_RESRDY_vect) {
+	if (timed) {
+		uint16_t latency = ADC_TIMER.CNT;
+		timing_stats.results++;
+		timing_stats.latency_sum += latency;
+		if (latency < timing_stats.latency_min)
+			timing_stats.latency_min = latency;
+		if (latency > timing_stats.latency_max)
+			timing_stats.latency_max = latency;
+	}
+
+	uint16_t result = ADC0.RES;
+
+	if (scan_channels != 0) {
+		uint8_t channel = scan_index;
+		uint8_t next = channel + 1;
+		if (next == scan_channels)
+			next = 0;
+		ADC0.MUXPOS = scan_muxpos[next];
+		ADC0.COMMAND = ADC_STCONV_bm;
+		scan_index = next;
+
+		// 32-bit time: RTC.CNT wraps every 2s, results come much more often //
+		uint16_t now = RTC.CNT;
+		if (now < time_last)
+			time_high++;
+		time_last = now;
+
+		volatile scan_ring* ring = &scan_rings[channel];
+		uint8_t head = ring->head;
+		uint8_t following = (head + 1) & (ADC_SCAN_RING_SIZE - 1);
+
+		if (following == ring->tail) {
+			if (overflows != 0xFFFF)
+				overflows++;
+			return;
+		}
+
+		ring->samples[head].value = result;
+		ring->samples[head].time = (static_cast<uint32_t>(time_high) << 16) | now;
+		ring->head = following;
+		return;
+	}
+
+	uint8_t head = ring_head;
+	uint8_t next = (head + 1) & (ADC_RING_SIZE - 1);
+
+	if (next == ring_tail) {
+		if (overflows != 0xFFFF)
+			overflows++;
+		return;
+	}
+
+	ring[head] = result;
+	ring_head = next;
+}
+
+/*
+*	Result outside the window: report it and centre the window on it.
+*/
+ISR(ADC0_WCMP_vect) {
+	uint16_t result = ADC0.RES;
+	ADC0.INTFLAGS = ADC_WCMP_bm;
+
+	ADC0.WINLT = (result > notify_deadband) ? static_cast<uint16_t>(result - notify_deadband) : 0;
+	ADC0.WINHT = (result < 0xFFFF - notify_deadband) ? static_cast<uint16_t>(result + notify_deadband) : 0xFFFF;
+
+	notify_value = result;
+	notify_changed = true;
+}
@@ -0,0 +1,155 @@
+/*
+ ***********************************************************************************
+ * @file:   AVR128DB48_ADC.h
+ * @date:   16.10.2026
+ *
+ * This module runs ADC0 in free-running mode. Every result raises the RESRDY interrupt,
+ * the interrupt copies RES into a ring buffer and the application takes the samples out
+ * in batches whenever it has time (e.g. between two LCD updates). Between the batches the
+ * CPU does not wait for a single conversion.
+ *
+ * The ring has exactly one writer (ADC0_RESRDY_vect, moves the head) and one reader
+ * (adc_readSamples(), moves the tail). Both indices are 8 bit and are therefore read and
+ * written in one instruction, no interrupt lock is needed for the samples.
+ * If the application is too slow, new samples are dropped and counted (adc_overflows()),
+ * the samples in the ring stay in order.
+ *
+ * Oversampling: the ADC can add up 2 ... 128 samples in hardware (SAMPNUM) before it
+ * reports one result. adc_setOversampling() selects the number of samples and the
+ * resolution of the results (12 ... 16 bit, fixed point: result = mean * 2^(resolution - 12)).
+ * Trade-off for white noise (random noise of at least ~1 LSB):
+ *
+ *   samples   results per second   noise (RMS)   effective bits
+ *         1        rate                1             12
+ *         4        rate / 4            1/2           13
+ *        16        rate / 16           1/4           14
+ *        64        rate / 64           1/8           15
+ *       128        rate / 128          1/11          15.5
+ *
+ * Bits beyond the effective bits (adc_effectiveBits()) only add noise and steps,
+ * the rate is reported by adc_resultRate(). Above 16 samples the 16-bit RES register
+ * only holds the upper 16 bits of the sum, the module corrects this.
+ *
+ * Scan: adc_startScan() converts a list of inputs one after another. The RESRDY interrupt
+ * stores the result of one input, switches MUXPOS to the next one and starts its conversion
+ * right away, so all inputs together are sampled at the fixed rate adc_resultRate() and
+ * every input at adc_resultRate() / channels. Every input has its own ring; each sample
+ * carries the RTC time when its result was ready (1/32768 s, 32 bit, wraps after ~36 hours).
+ *
+ * Timed: adc_startTimed() lets TCB0 start every conversion through the event system
+ * (TCB0 CAPT -> EVSYS channel 0 -> ADC0 START). The sampling instants are set by the timer
+ * alone, the CPU is not involved per trigger and a busy LCD / I2C cannot delay them.
+ * Only the RESRDY interrupt that copies the result can be late; adc_readTiming() reports
+ * its latency after the trigger (TCB0.CNT in the interrupt). As long as the largest latency
+ * stays below the period, no result is lost and the data has an exact sample clock.
+ *
+ * Notify on change: adc_startNotify() lets the ADC run free with the window comparator
+ * instead of the RESRDY interrupt. The WCMP interrupt only fires when a result leaves the
+ * window around the last reported value; it reports the new value and centres the window
+ * on it again (value - deadband ... value + deadband). Noise inside the deadband costs no
+ * CPU time at all, adc_waitChange() sleeps (idle mode) until the reading really moves.
+ *
+ * FYI: Conversion time (AVR128DB48 Data sheet -> ADC) is about
+ *      (2 + SAMPLEN) CLK_ADC for sampling + 13 CLK_ADC for the 12-bit conversion.
+ *      With F_CPU = 4MHz, ADC_CLOCK_DIV = 16 and ADC_SAMPLE_LENGTH = 31 that is
+ *      46 * 4us = 184us, i.e. ~5.4k samples per second and ~740 CPU cycles per sample.
+ *      A faster ADC clock gives more samples but less CPU time per interrupt.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Connections:
+  Any analog input, e.g. PF2 (AIN18) or PF3 (AIN19). The pin must be an input.
+  adc_startTimed() uses TCB0 and event channel 0.
+
+  Usage:
+  1. Call adc_init() and adc_startFreeRunning() with the input channel, then sei().
+  2. Take the samples out with adc_readSamples() (as many as there are, up to max)
+     or wait until adc_available() reports a full batch.
+  3. adc_overflows() tells if the ring was too small for the time between two batches.
+  4. adc_stop() ends the conversions; adc_read() measures once by polling (not while free-running).
+  5. adc_setOversampling(ADC_SAMPNUM_ACC16_gc, 14) before starting: every result is the mean
+     of 16 samples in 14 bit (0 ... 16383). Use adc_resolution() for adc_scale_setup().
+  6. Several inputs: adc_startScan() with a list of channels instead of adc_startFreeRunning(),
+     then adc_readScan() per channel (index in the list). The scan uses the RTC as time base
+     (32.768kHz internal oscillator) and starts it if it is not running.
+  7. Exact sample rate: adc_startTimed() instead of adc_startFreeRunning(), the samples are
+     read the same way. adc_readTiming() shows the interrupt latency while the application runs.
+  8. Only changes: adc_startNotify() with a deadband, then adc_waitChange() (sleeps) or
+     adc_changed() (does not wait) return the value whenever it moved by more than the deadband.
+*/
+
+
+#ifndef AVR128DB48_ADC_H_
+#define AVR128DB48_ADC_H_
+
+// INCLUDES //
+#include <avr/io.h>
+#include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
+
+
+// DEFINES //
+#ifndef ADC_RING_SIZE
+#define ADC_RING_SIZE		64						// Slots of the ring, one stays free (must be a power of two, at most 128)
+#endif
+
+#ifndef ADC_SCAN_CHANNELS
+#define ADC_SCAN_CHANNELS	4						// Inputs in one scan
+#endif
+
+#ifndef ADC_SCAN_RING_SIZE
+#define ADC_SCAN_RING_SIZE	16						// Slots of the ring of every scanned input (power of two, at most 128)
+#endif
+
+#ifndef ADC_CLOCK_DIV
+#define ADC_CLOCK_DIV		16						// CLK_ADC = F_CPU / ADC_CLOCK_DIV (2, 4, 8, ... 256)
+#endif
+
+#ifndef ADC_SAMPLE_LENGTH
+#define ADC_SAMPLE_LENGTH	31						// Additional sampling time in CLK_ADC (SAMPCTRL)
+#endif
+
+
+// TYPES //
+// Result of one input in a scan //
+typedef struct {
+	uint16_t value;		// In adc_resolution() bits
+	uint32_t time;		// RTC time when the result was ready (1/32768 s)
+} adc_sample;
+
+// Interrupt latency of the timed conversions (adc_startTimed()) //
+typedef struct {
+	uint32_t results;		// Results since the start / last reset
+	uint32_t latency_sum;	// Sum of the latencies (mean = latency_sum / results)
+	uint16_t latency_min;	// Timer ticks from the trigger to the interrupt (conversion + interrupt latency)
+	uint16_t latency_max;
+	uint16_t period;		// Timer ticks per sample (for comparison with latency_max)
+} adc_timing;
+
+
+// FUNCTION DECLARATIONS //
+void adc_init(); // Removed void from parameter list for C++
+void adc_startFreeRunning(uint8_t muxpos);
+void adc_stop(); // Removed void from parameter list for C++
+uint16_t adc_read(uint8_t muxpos);
+uint8_t adc_available(); // Removed void from parameter list for C++
+uint8_t adc_readSamples(uint16_t* samples, uint8_t max);
+uint16_t adc_overflows(); // Removed void from parameter list for C++
+bool adc_setOversampling(uint8_t accumulation, uint8_t resolution);
+uint8_t adc_resolution(); // Removed void from parameter list for C++
+uint8_t adc_effectiveBits(); // Removed void from parameter list for C++
+uint16_t adc_resultRate(); // Removed void from parameter list for C++
+bool adc_startScan(const uint8_t* muxpos, uint8_t channels);
+uint8_t adc_scanAvailable(uint8_t channel);
+uint8_t adc_readScan(uint8_t channel, adc_sample* samples, uint8_t max);
+bool adc_startTimed(uint8_t muxpos, uint16_t rate);
+void adc_readTiming(adc_timing* timing, bool reset);
+void adc_startNotify(uint8_t muxpos, uint16_t deadband);
+bool adc_changed(uint16_t* value);
+uint16_t adc_waitChange(); // Removed void from parameter list for C++
+
+#endif /* AVR128DB48_ADC_H_ */
@@ -5,9 +5,12 @@
  * @date:   20.09.2022
  *
  * This module initializes the I2C Bus as Master and provides functions for usage.
+ * All transfers run in the TWI0 master interrupt (TWI0_TWIM_vect). Transactions are
+ * queued in a fixed-size ring of descriptors and started one after another, so the
+ * CPU only spends a few cycles per byte instead of busy-waiting on the bus.
  *
- * FYI: This I2C Implementation is currently limited to Normal Mode (100kHz Speed),
- *      due to the CPU-Speeds required for faster rates.
+ * FYI: The baud setting of every i2c_mode is computed at compile time from F_CPU and
+ *      I2C_RISE_TIME_NS. Modes that are out of reach for the clock are rejected by i2c_init().
  *
  * *********************************************************************************
  *
@@ -22,33 +25,111 @@
 
 // INLCUDES //
 #include "AVR128DB48_I2C.h"
+#include <avr/interrupt.h>
+#ifndef F_CPU
 #define F_CPU 4000000
+#endif
 #include <util/delay.h>
 
 // DEFINES //
 #define I2C_WRITE		0		// Write Bit in Address
 #define I2C_READ		1		// Write Bit in Address
 
+#define MBAUD_INVALID	-1		// Mode cannot be reached with this F_CPU / rise time
+
+static_assert((I2C_QUEUE_SIZE & (I2C_QUEUE_SIZE - 1)) == 0, "I2C_QUEUE_SIZE must be a power of two");
+static_assert(I2C_QUEUE_SIZE <= 128, "I2C_QUEUE_SIZE must fit into the 8-bit queue indices");
+
+/*
+*	Baud-Setting for a given SCL frequency (AVR128DB48 Data sheet -> Two-Wire Interface):
+*	f_SCL = F_CPU / (10 + 2 * BAUD + F_CPU * T_r),  t_LOW = (BAUD + 5) / F_CPU
+*	F_CPU / f_SCL and the rise time (F_CPU * T_r) are rounded up to whole cycles, BAUD is rounded
+*	up (at least 0) and raised until t_LOW meets the minimum of the mode, so the bus never runs
+*	faster than requested. A slow F_CPU only lowers f_SCL (e.g. Fast Mode at 4MHz and 200ns:
+*	BAUD = 1, about 312kHz, t_LOW = 1.5us). Returns MBAUD_INVALID if the rise time exceeds the
+*	limit of the mode (I2C specification) or BAUD does not fit in 0..255.
+*/
+static constexpr int32_t ceil_cycles(uint32_t time_ns) {
+	return static_cast<int32_t>((static_cast<uint64_t>(F_CPU) * time_ns + 999999999ULL) / 1000000000ULL);
+}
+
+static constexpr int32_t baud_cycles(uint32_t f_scl) {
+	return static_cast<int32_t>((F_CPU + f_scl - 1) / f_scl) - 10 - ceil_cycles(I2C_RISE_TIME_NS);
+}
+
+static constexpr int32_t baud_low_time(uint16_t min_low_time_ns) {
+	return (ceil_cycles(min_low_time_ns) > 5) ? ceil_cycles(min_low_time_ns) - 5 : 0;
+}
+
+static constexpr int32_t baud_frequency(uint32_t f_scl) {
+	return (baud_cycles(f_scl) > 0) ? (baud_cycles(f_scl) + 1) / 2 : 0;
+}
+
+static constexpr int32_t baud_raw(uint32_t f_scl, uint16_t min_low_time_ns) {
+	return (baud_frequency(f_scl) > baud_low_time(min_low_time_ns))
+		? baud_frequency(f_scl)
+		: baud_low_time(min_low_time_ns);
+}
+
+static constexpr int16_t baud_setting(uint32_t f_scl, uint16_t max_rise_time_ns, uint16_t min_low_time_ns) {
+	return (I2C_RISE_TIME_NS > max_rise_time_ns || baud_raw(f_scl, min_low_time_ns) > 255)
+		? MBAUD_INVALID
+		: static_cast<int16_t>(baud_raw(f_scl, min_low_time_ns));
+}
+
+static constexpr int16_t baud_normal_mode		= baud_setting(100000UL, 1000, 4700);	// 100kHz, T_r max. 1000ns, t_LOW min. 4.7us
+static constexpr int16_t baud_fast_mode			= baud_setting(400000UL, 300, 1300);	// 400kHz, T_r max. 300ns,  t_LOW min. 1.3us
+static constexpr int16_t baud_fast_mode_plus	= baud_setting(1000000UL, 120, 500);	// 1MHz,   T_r max. 120ns,  t_LOW min. 0.5us
+
+static_assert(baud_normal_mode != MBAUD_INVALID, "F_CPU / I2C_RISE_TIME_NS do not allow 100kHz I2C");
+static_assert(F_CPU < 4000000UL || I2C_RISE_TIME_NS > 300 || baud_fast_mode != MBAUD_INVALID, "Fast Mode must be available from 4MHz on");
+
 // Variables //
-volatile i2c_status status;
+static i2c_transaction* volatile	queue[I2C_QUEUE_SIZE];	// Transactions waiting for the bus, queue[head] is on the bus
+static volatile uint8_t				queue_head = 0;			// Index of the active transaction
+static volatile uint8_t				queue_count = 0;		// Number of queued transactions (including the active one)
+static volatile uint8_t				position = 0;			// Index of the next byte of the active transaction
+static volatile bool				reading = false;		// Active transaction is in its read phase
 
 // PRIVATE FUNCTION DECLARATIONS //
-static void			wait_for_state_change(); // Removed void from parameter list for C++
-static i2c_status	check_errors(); // Removed void from parameter list for C++
+static void			start_transaction(); // Removed void from parameter list for C++
+static void			finish_transaction(i2c_status result);
+static void			service_master(); // Removed void from parameter list for C++
+static void			poll_master(); // Removed void from parameter list for C++
 
 // PUBLIC FUNCTIONS //
 /*
-*	Initializes the I2C Bus in Normal Mode and this device as Master
-*	@return None
+*	Initializes the I2C Bus in the given mode and this device as Master
+*
+*	@param mode Bus speed: NORMAL_MODE (100kHz), FAST_MODE (400kHz) or FAST_MODE_PLUS (1MHz)
+*	@return i2c_status ERROR if the mode cannot be reached with F_CPU,
+*			ERROR_NOT_READY if transactions are still queued (they would never complete),
+*			otherwise SUCCESS
 */
-void i2c_init() { // Removed void from parameter list for C++
-	
+i2c_status i2c_init(i2c_mode mode) {
+
+	if (queue_count != 0)
+		return ERROR_NOT_READY;		// Wait for i2c_busy() == false before re-initializing
+
+	int16_t baud;
+	switch (mode) {
+		case FAST_MODE:			baud = baud_fast_mode;			break;
+		case FAST_MODE_PLUS:	baud = baud_fast_mode_plus;		break;
+		default:				baud = baud_normal_mode;		break;
+	}
+	if (baud == MBAUD_INVALID)
+		return ERROR;
+
 	// I2C Configuration //
-	TWI0.CTRLA = TWI_SDAHOLD_50NS_gc;	// Set Holdtime to 50ns
-	
+	TWI0.MCTRLA = 0;						// Disable Master while changing the configuration
+	if (mode == FAST_MODE_PLUS)
+		TWI0.CTRLA = TWI_SDAHOLD_50NS_gc | TWI_FMPEN_bm;	// Set Holdtime to 50ns, enable Fast Mode Plus drive strength
+	else
+		TWI0.CTRLA = TWI_SDAHOLD_50NS_gc;	// Set Holdtime to 50ns
+
 	// Enable Run in Debug //
 	TWI0.DBGCTRL = TWI_DBGRUN_bm;
-																					
+
 	// Clear Master Status Register //
 	TWI0.MSTATUS = TWI_RIF_bm |				// Clear Read Interrupt Flag
 				   TWI_WIF_bm |				// Clear Write Interrupt Flag
@@ -57,17 +138,95 @@ void i2c_init() { // Removed void from parameter list for C++
 				   TWI_ARBLOST_bm |			// Clear Arbitration Lost Flag
 				   TWI_BUSERR_bm |			// Clear Bus Error Flag
 				   TWI_BUSSTATE_IDLE_gc;	// Force Master into IDLE-Mode
-	
+
 	// Master Configuration //
-	TWI0.MBAUD = 15;		// Calculated Baud-Setting based on F_CPU = 4000000 and T_r (Rise time for both SDA and SCL, found in AVR128DB48 Data sheet -> Electrical Characteristics)
-							// Formula is found in AVR128DB48 Data sheet -> Two-Wire Interface
-							// Results in ~100kHz
-	
-	TWI0.MCTRLA = TWI_ENABLE_bm;	// Use this device as Master withput any Interrupts
+	TWI0.MBAUD = static_cast<uint8_t>(baud);	// Calculated Baud-Setting based on F_CPU and T_r, see baud_setting()
+
+	// Reset Transaction Queue //
+	queue_head = 0;
+	queue_count = 0;
+
+	TWI0.MCTRLA = TWI_RIEN_bm |				// Read Interrupt: a byte has been received
+				  TWI_WIEN_bm |				// Write Interrupt: address / byte has been sent (or an error occurred)
+				  TWI_ENABLE_bm;			// Use this device as Master
+
+	return SUCCESS;
+}
+
+/*
+*	Queues a transaction. It is started immediately if the bus is free,
+*	otherwise after all previously queued transactions have finished.
+*	The function returns at once; completion is signalled by transaction->done
+*	and the optional callback (which runs in interrupt context).
+*
+*	@param transaction Descriptor of the transfer, must stay valid until done is true
+*	@return bool false if the queue is full (transaction was not queued)
+*/
+bool i2c_submit(i2c_transaction* transaction) {
+
+	transaction->status = SUCCESS;
+	transaction->done = false;
+
+	uint8_t sreg = SREG;	// Queue is shared with the TWI interrupt
+	cli();
+
+	if (queue_count >= I2C_QUEUE_SIZE) {
+		SREG = sreg;
+		return false;
+	}
+
+	queue[(queue_head + queue_count) & (I2C_QUEUE_SIZE - 1)] = transaction;
+	queue_count++;
+
+	// Bus is free -> start right away //
+	if (queue_count == 1)
+		start_transaction();
+
+	SREG = sreg;
+	return true;
+}
+
+/*
+*	Queues a transaction like i2c_submit(), but waits for a free queue slot
+*	instead of failing if the queue is full. Returns as soon as it is queued.
+*
+*	@param transaction Descriptor of the transfer, must stay valid until done is true
+*/
+void i2c_enqueue(i2c_transaction* transaction) {
+
+	while (!i2c_submit(transaction)) {
+		poll_master();
+	}
+}
+
+/*
+*	Waits until a submitted transaction has finished.
+*	If global interrupts are disabled, the TWI flags are serviced by polling.
+*
+*	@param transaction Previously submitted transaction
+*	@return i2c_status Status code of the transaction
+*/
+i2c_status i2c_wait(i2c_transaction* transaction) {
+
+	while (!transaction->done) {
+		poll_master();
+	}
+
+	return transaction->status;
+}
+
+/*
+*	Checks whether any transaction is queued or on the bus.
+*
+*	@return bool true while the queue is not empty
+*/
+bool i2c_busy() { // Removed void from parameter list for C++
+	return queue_count != 0;
 }
 
 /*
 *	Writes data to the specified device address.
+*	Blocks until the transaction has finished.
 *
 *	@param address Address of the target device
 *	@param data Data as Byte-Array to be send
@@ -75,87 +234,33 @@ void i2c_init() { // Removed void from parameter list for C++
 *	@return i2c_status Status code after execution
 */
 i2c_status i2c_write(uint8_t address, uint8_t* data, uint8_t length) {
-	
-	// Check if Master is not in idle //
-	if((TWI0.MSTATUS & TWI_BUSSTATE_IDLE_gc) != TWI_BUSSTATE_IDLE_gc)
-		return ERROR_NOT_READY;
-	
-	// Transmit Address //
-	TWI0.MADDR = static_cast<uint8_t>((address << 1) | I2C_WRITE);	// Start write operation by writing the address to the MADDR register, 
-												// initiating the transmission
-	
-	// Wait for change in bus state //
-	wait_for_state_change();
-	
-	// Check any bus errors //
-	check_errors();
-
-	// Transmit Data //
-	uint8_t pos = 0;
-	while(pos < length) {
-		
-		TWI0.MDATA = data[pos++];
-		
-		wait_for_state_change();
-		
-		// Check for NACK //
-		if(static_cast<bool>(TWI0.MSTATUS & TWI_RXACK_bm)) { // Cast to bool
-			TWI0.MCTRLB = TWI_MCMD_STOP_gc;		// -> Stop transmission
-			return NACK;
-		}
-	}
-	
-	// Stop Transmission //
-	TWI0.MCTRLB = TWI_MCMD_STOP_gc;
-	
-	return SUCCESS;
+
+	i2c_transaction transaction = {};
+	transaction.address = address;
+	transaction.tx_data = data;
+	transaction.tx_length = length;
+
+	i2c_enqueue(&transaction);
+
+	return i2c_wait(&transaction);
 }
 
 /*
 *	Writes one byte of data to the specified device address.
-*	A transmission takes approximately 300 microseconds.
+*	A transmission takes approximately 300 microseconds, during which
+*	the CPU only waits for the TWI interrupt.
 *
 *	@param address Address of the target device
 *	@param data Data-Byte
 *	@return i2c_status Status code after execution
 */
 i2c_status i2c_write_byte(uint8_t address, uint8_t data) {
-
-	// Check if Master is not in idle //
-	if((TWI0.MSTATUS & TWI_BUSSTATE_IDLE_gc) != TWI_BUSSTATE_IDLE_gc)
-		return ERROR_NOT_READY;
-	
-	// Transmit Address //
-	TWI0.MADDR = static_cast<uint8_t>((address << 1) | I2C_WRITE);	// Start write operation by writing the address to the MADDR register,
-												// initiating the transmission
-	
-	// Wait for change in bus state //
-	wait_for_state_change();
-	
-	// Check any bus errors //
-	status = check_errors();
-	if(status != SUCCESS)
-		return status;
-	
-	// Transmit Data //
-	TWI0.MDATA = data;
-		
-	// Wait for change in bus state //
-	wait_for_state_change();
-	
-	// Check any bus errors //
-	status = check_errors();
-	if(status != SUCCESS)
-		return status;
-	
-	// Stop Transmission //
-	TWI0.MCTRLB = TWI_MCMD_STOP_gc;
-	
-	return SUCCESS;	
+	return i2c_write(address, &data, 1);
 }
 
 /*
 *	Read data from the specified device address.
+*	Blocks until the transaction has finished.
 *
 *	@param address Address of the target device
 *	@param data Byte-Array to save read data
@@ -164,44 +269,40 @@ i2c_status i2c_write_byte(uint8_t address, uint8_t data) {
 */
 i2c_status i2c_read(uint8_t address, uint8_t* data, uint8_t length) {
 
-	// Check if Master is not in idle //
-	if((TWI0.MSTATUS & TWI_BUSSTATE_IDLE_gc) != TWI_BUSSTATE_IDLE_gc)
-		return ERROR_NOT_READY;
-	
-	// Transmit Address //
-	TWI0.MADDR = static_cast<uint8_t>((address << 1) + I2C_READ);		// Start read operation by writing the address to the MADDR register,
-												// initiating the transmission
-	
-	// Wait for change in bus state //
-	wait_for_state_change();
-	
-	// Check any bus errors //
-	status = check_errors();
-	if(status != SUCCESS)
-		return status;
-	
-	// Release Clock //
-	TWI0.MSTATUS = TWI_CLKHOLD_bm;
-		
-	uint8_t pos = 0;
-	while (pos < length)
-	{
-		// Wait until data is received //
-		wait_for_state_change();
-		
-		// Store incoming byte //
-		data[pos++] = TWI0.MDATA;
-		
-		// Send ACK and get ready to read next byte, if transmission is still ongoing //
-		if (pos != length) {
-			TWI0.MCTRLB = TWI_ACKACT_ACK_gc | TWI_MCMD_RECVTRANS_gc;
-		}
-	}
-	
-	// Finish transmission with NACK and stop it //
-	TWI0.MCTRLB = TWI_ACKACT_NACK_gc | TWI_MCMD_STOP_gc;
-		
-	return SUCCESS;		
+	i2c_transaction transaction = {};
+	transaction.address = address;
+	transaction.rx_data = data;
+	transaction.rx_length = length;
+
+	i2c_enqueue(&transaction);
+
+	return i2c_wait(&transaction);
+}
+
+/*
+*	Writes data to the specified device address and reads the answer in the same transaction.
+*	The bus is not released in between: after the last written byte a repeated START
+*	with the read address is sent, so register reads need no second START/STOP and no pause.
+*
+*	@param address Address of the target device
+*	@param tx_data Bytes to be send first (e.g. the register address)
+*	@param tx_length Length of tx_data
+*	@param rx_data Byte-Array to save read data
+*	@param rx_length Length of the expected answer
+*	@return i2c_status Status code after execution
+*/
+i2c_status i2c_write_read(uint8_t address, uint8_t* tx_data, uint8_t tx_length, uint8_t* rx_data, uint8_t rx_length) {
+
+	i2c_transaction transaction = {};
+	transaction.address = address;
+	transaction.tx_data = tx_data;
+	transaction.tx_length = tx_length;
+	transaction.rx_data = rx_data;
+	transaction.rx_length = rx_length;
+
+	i2c_enqueue(&transaction);
+
+	return i2c_wait(&transaction);
 }
 
 /*
@@ -212,66 +313,141 @@ i2c_status i2c_read(uint8_t address, uint8_t* data, uint8_t length) {
 *	@return i2c_status Status code after execution
 */
 i2c_status i2c_read_byte(uint8_t address, uint8_t* data) {
-	
+	return i2c_read(address, data, 1);
+}
+
+// INTERRUPTS //
+ISR(TWI0_TWIM_vect) {
+	service_master();
+}
+
+// PRIVATE FUNCTIONS //
+
+/*
+*	Puts the transaction at the head of the queue onto the bus.
+*	Must be called with interrupts disabled.
+*/
+static void start_transaction() { // Removed void from parameter list for C++
+
+	i2c_transaction* transaction = queue[queue_head];
+	position = 0;
+
 	// Check if Master is not in idle //
-	if((TWI0.MSTATUS & TWI_BUSSTATE_IDLE_gc) != TWI_BUSSTATE_IDLE_gc)
-		return ERROR_NOT_READY;
-	
+	if((TWI0.MSTATUS & TWI_BUSSTATE_gm) == TWI_BUSSTATE_BUSY_gc) {
+		finish_transaction(ERROR_NOT_READY);
+		return;
+	}
+
 	// Transmit Address //
-	TWI0.MADDR = static_cast<uint8_t>((address << 1) | I2C_READ);	// Start write operation by writing the address to the MADDR register,
-	// initiating the transmission
-	
-	// Wait for change in bus state //
-	wait_for_state_change();
-	
-	// Check any bus errors //
-	status = check_errors();
-	if(status != SUCCESS)
-		return status;
-	
-	// Release Clock //
-	TWI0.MSTATUS = TWI_CLKHOLD_bm;
-	
-	// Wait until data is received //
-	wait_for_state_change();
-	
-	// Read Data //
-	data[0] = TWI0.MDATA;
-	
-    //NACK and STOP the bus
-    TWI0.MCTRLB = TWI_ACKACT_NACK_gc | TWI_MCMD_STOP_gc;
-	
-	return SUCCESS;
+	reading = (transaction->tx_length == 0 && transaction->rx_length != 0);
+	if (reading)
+		TWI0.MADDR = static_cast<uint8_t>((transaction->address << 1) | I2C_READ);	// Start read operation
+	else
+		TWI0.MADDR = static_cast<uint8_t>((transaction->address << 1) | I2C_WRITE);	// Start write operation
 }
 
-// PRIVATE FUNCTIONS //
-static void wait_for_state_change() { // Removed void from parameter list for C++
-	// Wait for completion of address transmission / for an error //	// Wait until one state is true:
-	while (!(static_cast<bool>(TWI0.MSTATUS & TWI_CLKHOLD_bm) ||							// Clockhold is active	(Transmission was successful)
-	static_cast<bool>(TWI0.MSTATUS & TWI_BUSERR_bm)   ||									// A bus error occured
-	static_cast<bool>(TWI0.MSTATUS & TWI_ARBLOST_bm)  ||									// Arbitration is lost
-	static_cast<bool>((TWI0.MSTATUS & TWI_BUSSTATE_BUSY_gc) == TWI_BUSSTATE_BUSY_gc))	// Bus switches to busy
-	);
+/*
+*	Stores the result of the active transaction, removes it from the queue
+*	and starts the next one. Must be called with interrupts disabled.
+*/
+static void finish_transaction(i2c_status result) {
+
+	i2c_transaction* transaction = queue[queue_head];
+
+	queue_head = (queue_head + 1) & (I2C_QUEUE_SIZE - 1);
+	queue_count--;
+
+	transaction->status = result;
+	transaction->done = true;
+
+	// Keep the bus busy before running user code //
+	if (queue_count != 0)
+		start_transaction();
+
+	if (transaction->callback != 0)
+		transaction->callback(result, transaction->context);
 }
 
-static i2c_status check_errors() { // Removed void from parameter list for C++
+/*
+*	State machine of the master. Runs once per WIF / RIF event,
+*	either from the TWI interrupt or from poll_master().
+*/
+static void service_master() { // Removed void from parameter list for C++
+
+	if (queue_count == 0) {
+		TWI0.MSTATUS = TWI_RIF_bm | TWI_WIF_bm;		// Spurious event, nothing to do
+		return;
+	}
+
+	i2c_transaction* transaction = queue[queue_head];
+	uint8_t mstatus = TWI0.MSTATUS;
+
 	// Check for errors //
-	if(static_cast<bool>(TWI0.MSTATUS & TWI_RXACK_bp)) {											// Check for NACK
-		TWI0.MCTRLB = TWI_MCMD_STOP_gc;											// -> Stop transmission
-		return NACK;
+	if (static_cast<bool>(mstatus & TWI_ARBLOST_bm)) {				// Check for arbitration lost
+		TWI0.MSTATUS = TWI_ARBLOST_bm | TWI_RIF_bm | TWI_WIF_bm;
+		finish_transaction(ARBITRATION_LOST);
+		return;
 	}
-	if(static_cast<bool>(TWI0.MSTATUS & TWI_ARBLOST_bm)) {											// Check for arbitration lost
-		TWI0.MCTRLB = TWI_MCMD_STOP_gc;											// -> Stop transmission
-		return ARBITRATION_LOST;
+	if (static_cast<bool>(mstatus & TWI_BUSERR_bm)) {				// Check for bus error
+		TWI0.MSTATUS = TWI_BUSERR_bm | TWI_RIF_bm | TWI_WIF_bm;
+		finish_transaction(ERROR);
+		return;
 	}
-	if(static_cast<bool>(TWI0.MSTATUS & TWI_BUSERR_bm)) {											// Check for bus error
-		TWI0.MCTRLB = TWI_MCMD_STOP_gc;											// -> Stop transmission
-		return ERROR;
+
+	// Byte has been received //
+	if (static_cast<bool>(mstatus & TWI_RIF_bm)) {
+
+		transaction->rx_data[position++] = TWI0.MDATA;
+
+		if (position < transaction->rx_length) {
+			TWI0.MCTRLB = TWI_ACKACT_ACK_gc | TWI_MCMD_RECVTRANS_gc;	// Send ACK and read next byte
+		}
+		else {
+			TWI0.MCTRLB = TWI_ACKACT_NACK_gc | TWI_MCMD_STOP_gc;		// Finish transmission with NACK and stop it
+			finish_transaction(SUCCESS);
+		}
+		return;
 	}
-	if(static_cast<bool>((TWI0.MSTATUS & TWI_BUSSTATE_BUSY_gc) == TWI_BUSSTATE_BUSY_gc)) {			// Check if bus is busy
-		TWI0.MCTRLB = TWI_MCMD_STOP_gc;											// -> Stop transmission
-		return ERROR_NOT_READY;
+
+	// Address or byte has been sent //
+	if (static_cast<bool>(mstatus & TWI_WIF_bm)) {
+
+		// Check for NACK //
+		if (static_cast<bool>(mstatus & TWI_RXACK_bm)) {
+			TWI0.MCTRLB = TWI_MCMD_STOP_gc;		// -> Stop transmission
+			finish_transaction(NACK);
+			return;
+		}
+
+		// Transmit Data //
+		if (!reading && position < transaction->tx_length) {
+			TWI0.MDATA = transaction->tx_data[position++];
+			return;
+		}
+
+		// Repeated Start: MADDR is written while the clock is still held //
+		if (!reading && transaction->rx_length != 0) {
+			reading = true;
+			position = 0;
+			TWI0.MADDR = static_cast<uint8_t>((transaction->address << 1) | I2C_READ);
+			return;
+		}
+
+		// Stop Transmission //
+		TWI0.MCTRLB = TWI_MCMD_STOP_gc;
+		finish_transaction(SUCCESS);
 	}
-	
-	return SUCCESS;
+}
+
+/*
+*	Runs the state machine by hand if the TWI interrupt cannot fire,
+*	because global interrupts are disabled (e.g. blocking call inside an ISR).
+*/
+static void poll_master() { // Removed void from parameter list for C++
+
+	if (static_cast<bool>(SREG & CPU_I_bm))
+		return;		// Interrupt is going to handle it
+
+	if (static_cast<bool>(TWI0.MSTATUS & (TWI_RIF_bm | TWI_WIF_bm)))
+		service_master();
 }
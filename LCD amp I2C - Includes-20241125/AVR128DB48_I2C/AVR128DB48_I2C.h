@@ -5,9 +5,17 @@
  * @date:   20.09.2022
  *
  * This module initializes the I2C Bus as Master and provides functions for usage.
+ * Transfers are driven by the TWI0 master interrupt from a queue of transaction descriptors,
+ * so the CPU is free while bytes are shifted out. The classic i2c_read() / i2c_write()
+ * functions are blocking wrappers on top of that queue.
  *
- * FYI: This I2C Implementation is currently limited to Normal Mode (100kHz Speed),
- *      due to the CPU-Speeds required for faster rates.
+ * FYI: Fast Mode runs at about 312kHz at the default 4MHz (MBAUD = 1 with I2C_RISE_TIME_NS
+ *      = 200) and at 340..355kHz with faster clocks, the minimum t_LOW of 1.3us keeps it below
+ *      400kHz with 200ns rise time. Fast Mode Plus (1MHz) needs I2C_RISE_TIME_NS <= 120
+ *      (stronger pull-ups), with the default rise time it is rejected; at slow clocks it
+ *      also runs below its nominal speed. i2c_init() returns ERROR for modes that cannot be reached with the
+ *      configured clock and rise time.
+ *      The PCF8574 of the LCD module is only specified for 100kHz.
  *
  * *********************************************************************************
  *
@@ -23,8 +31,12 @@
   SDA - PA2
   SCL - PA3
   
-  1. Call i2c_init() before using any other function.                                                  
+  1. Call i2c_init() before using any other function (again only while i2c_busy() is false).                                                  
   2. Use i2c_read() or i2c_write() for transmitting and receiving data.
+     Use i2c_write_read() to read registers in one transaction (repeated START).
+  3. Or fill an i2c_transaction and hand it to i2c_submit() to transfer in the background.
+     The blocking functions also work with global interrupts disabled (e.g. from an ISR),
+     they then service the TWI flags by polling.
 */
 
 
@@ -33,6 +45,17 @@
 
 // INCLUDES //
 #include <avr/io.h>
+#include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
+
+
+// DEFINES //
+#ifndef I2C_RISE_TIME_NS
+#define I2C_RISE_TIME_NS	200	// Rise time of SDA / SCL in ns (estimate for 4.7kOhm pull-ups and short wires, use the measured value)
+#endif
+
+#ifndef I2C_QUEUE_SIZE
+#define I2C_QUEUE_SIZE	8	// Number of transactions that can wait for the bus (must be a power of two)
+#endif
 
 
 // ENUMS //
@@ -44,17 +67,35 @@ typedef enum {
 	ARBITRATION_LOST	// Arbitration was lost during transmission
 } i2c_status;
 
-/*
 typedef enum {
 	NORMAL_MODE,	// Bus operating at 100kHz
 	FAST_MODE,		// Bus operating at 400kHz
 	FAST_MODE_PLUS	// Bus operating at 1MHz
 } i2c_mode;
+
+// TYPES //
+typedef void (*i2c_callback)(i2c_status status, void* context);
+
+/*
+*	Descriptor of one bus transaction (START, address, data, STOP).
+*	tx_data is written first. If rx_length is not 0, a repeated START switches the bus to reading
+*	rx_data without releasing it in between (register read: tx_data = register address).
+*	The descriptor is owned by the caller and must stay valid until done is true.
 */
+typedef struct {
+	uint8_t					address;	// 7-Bit address of the target device
+	const uint8_t*			tx_data;	// Bytes to be written
+	uint8_t					tx_length;	// Number of bytes to be written
+	uint8_t*				rx_data;	// Storage for read bytes
+	uint8_t					rx_length;	// Number of bytes to be read
+	i2c_callback			callback;	// Called from the TWI interrupt after completion (may be 0)
+	void*					context;	// Passed to the callback
+	volatile i2c_status		status;		// Result of the transaction, valid once done is true
+	volatile bool			done;		// Set when the transaction has finished
+} i2c_transaction;
 
 // FUNCTION DECLARATIONS //
-//void i2c_init(i2c_mode mode);
-void i2c_init(); // Removed void from parameter list for C++
+i2c_status i2c_init(i2c_mode mode = NORMAL_MODE);
 
 i2c_status i2c_write(uint8_t address, uint8_t* data, uint8_t length);
 
@@ -64,5 +105,15 @@ i2c_status i2c_read(uint8_t address, uint8_t* data, uint8_t length);
 
 i2c_status i2c_read_byte(uint8_t address, uint8_t* data);
 
+i2c_status i2c_write_read(uint8_t address, uint8_t* tx_data, uint8_t tx_length, uint8_t* rx_data, uint8_t rx_length);
+
+bool i2c_submit(i2c_transaction* transaction);
+
+void i2c_enqueue(i2c_transaction* transaction);
+
+i2c_status i2c_wait(i2c_transaction* transaction);
+
+bool i2c_busy(); // Removed void from parameter list for C++
+
 
 #endif /* ARV128DB48_I2C_H_ */
\ No newline at end of file
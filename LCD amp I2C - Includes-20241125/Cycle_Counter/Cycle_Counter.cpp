@@ -0,0 +1,43 @@
+/*
+ ***********************************************************************************
+ * @file:   Cycle_Counter.cpp
+ * @date:   16.10.2026
+ *
+ * This module runs TCB2 as a free-running 16-bit counter on the peripheral clock.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+ */
+
+// INCLUDES //
+#include "Cycle_Counter.h"
+#ifndef F_CPU
+#define F_CPU 4000000
+#endif
+
+// PUBLIC FUNCTIONS //
+/*
+*	Starts the counter: periodic mode with TOP = 0xFFFF, no prescaler, no interrupts.
+*	@return None
+*/
+void cycle_counter_init() { // Removed void from parameter list for C++
+	CYCLE_COUNTER_TIMER.CTRLA = 0;						// Stop while configuring
+	CYCLE_COUNTER_TIMER.CTRLB = TCB_CNTMODE_INT_gc;		// Periodic Interrupt mode (counts 0..CCMP)
+	CYCLE_COUNTER_TIMER.CCMP = 0xFFFF;					// Full 16-bit range
+	CYCLE_COUNTER_TIMER.INTCTRL = 0;
+	CYCLE_COUNTER_TIMER.CNT = 0;
+	CYCLE_COUNTER_TIMER.CTRLA = TCB_CLKSEL_DIV1_gc | TCB_ENABLE_bm;
+}
+
+/*
+*	Converts cycles to microseconds (rounded).
+*	@param cycles Number of cycles
+*	@return uint16_t Duration in us
+*/
+uint16_t cycle_counter_to_us(uint32_t cycles) {
+	return static_cast<uint16_t>((cycles * 1000UL + F_CPU / 2000UL) / (F_CPU / 1000UL));
+}
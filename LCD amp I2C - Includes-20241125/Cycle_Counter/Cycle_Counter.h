@@ -0,0 +1,58 @@
+/*
+ ***********************************************************************************
+ * @file:   Cycle_Counter.h
+ * @date:   16.10.2026
+ *
+ * This module runs TCB2 as a free-running 16-bit counter on the peripheral clock.
+ * It is used to measure how many CPU cycles a piece of code (e.g. an ISR) takes.
+ * At F_CPU = 4MHz one tick is 0.25us, intervals up to ~16ms can be measured.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Usage:
+  1. Call cycle_counter_init() once.
+  2. uint16_t start = cycle_counter_now();
+     ... code to be measured ...
+     uint16_t cycles = cycle_counter_elapsed(start);
+*/
+
+
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+// INCLUDES //
+#include <avr/io.h>
+
+// DEFINES //
+#define CYCLE_COUNTER_TIMER	TCB2	// Timer used as time base, leaves TCB0 / TCB1 to the application
+
+// FUNCTION DECLARATIONS //
+void cycle_counter_init(); // Removed void from parameter list for C++
+
+uint16_t cycle_counter_to_us(uint32_t cycles);
+
+/*
+*	Current counter value (one tick per CPU cycle).
+*	@return uint16_t Counter value
+*/
+static inline uint16_t cycle_counter_now() { // Removed void from parameter list for C++
+	return CYCLE_COUNTER_TIMER.CNT;
+}
+
+/*
+*	Cycles since a previous call of cycle_counter_now().
+*	The two reads of CNT add a constant overhead of a few cycles.
+*
+*	@param start Value of cycle_counter_now() at the start of the measurement
+*	@return uint16_t Elapsed cycles (correct across one counter overflow)
+*/
+static inline uint16_t cycle_counter_elapsed(uint16_t start) {
+	return static_cast<uint16_t>(CYCLE_COUNTER_TIMER.CNT - start);
+}
+
+#endif /* CYCLE_COUNTER_H_ */
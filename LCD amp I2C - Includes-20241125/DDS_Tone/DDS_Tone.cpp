@@ -0,0 +1,445 @@
+/*
+ ***********************************************************************************
+ * @file:   DDS_Tone.cpp
+ * @date:   16.10.2026
+ *
+ * This module generates tones on DAC0 with one 32-bit phase accumulator per voice and
+ * a fixed sample rate, shapes every voice with an ADSR envelope, mixes up to DDS_VOICES voices
+ * and allocates them to keys (see DDS_Tone.h).
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+ */
+
+// INCLUDES //
+#include "DDS_Tone.h"
+#include <avr/interrupt.h>
+#include "No_Float.h"
+#ifndef F_CPU
+#define F_CPU 4000000
+#endif
+
+// DEFINES //
+#define DDS_TIMER		TCA0.SINGLE
+#define DDS_DAC_MID		512		// Zero line of the 10-bit DAC
+#define DDS_DAC_SHIFT	6		// DAC0.DATA holds the 10-bit value in bits 15:6
+#define DDS_MIX_MIN		(-DDS_DAC_MID)
+#define DDS_MIX_MAX		(DDS_DAC_MID - 1)
+#define DDS_NO_KEY		0xFF	// Voice not started by dds_noteOn()
+#define DDS_ENVELOPE_MAX	0xFFFF	// Envelope at full volume
+
+// Cycle budget of the sample interrupt (estimates, measured values: dds_cycles()) //
+#define DDS_CYCLES_BASE		90		// Entry / exit, mix, saturation, DAC, measurement
+#define DDS_CYCLES_VOICE	45		// Phase, table, multiplication per sounding voice
+#define DDS_CYCLES_ENVELOPE	70		// One envelope step (at most one per sample)
+#define DDS_CYCLES_EXIT		40		// Epilogue after the last CNT read: register pops and RETI (estimate)
+
+static_assert(F_CPU % DDS_SAMPLE_RATE == 0, "F_CPU must be a multiple of DDS_SAMPLE_RATE for an exact sample rate");
+static_assert(F_CPU / DDS_SAMPLE_RATE <= 0x10000UL, "DDS_SAMPLE_RATE too low for the 16-bit timer");
+static_assert(DDS_VOICES >= 1 && DDS_VOICES * 127L * DDS_MIX_GAIN <= 0x7FFF, "DDS_VOICES * DDS_MIX_GAIN too large for the 16-bit mix");
+static_assert(DDS_CONTROL_DIVIDER >= DDS_VOICES && DDS_CONTROL_DIVIDER <= 255, "DDS_CONTROL_DIVIDER must be DDS_VOICES ... 255");
+static_assert(DDS_CYCLES_BASE + DDS_VOICES * DDS_CYCLES_VOICE + DDS_CYCLES_ENVELOPE < F_CPU / DDS_SAMPLE_RATE,
+	"DDS_VOICES with envelopes do not fit into one sample period");
+
+// TYPES //
+typedef enum {
+	DDS_STAGE_OFF,		// Silent, voice is free
+	DDS_STAGE_ATTACK,		// Rising to DDS_ENVELOPE_MAX
+	DDS_STAGE_DECAY,		// Falling to the sustain level
+	DDS_STAGE_SUSTAIN,	// Holding the sustain level until the note ends
+	DDS_STAGE_RELEASE		// Falling to 0 after the note ended
+} dds_stage;
+
+typedef struct {
+	uint32_t phase;		// Position in the period (2^32 = one period)
+	uint32_t tuning;	// Phase increment per sample
+	uint16_t envelope;	// Envelope 0 ... DDS_ENVELOPE_MAX
+	uint8_t stage;		// dds_stage
+	uint8_t level;		// Volume of the note
+	uint8_t gain;		// level * envelope, used by the sample path
+} dds_voice;
+
+// VARIABLES //
+static volatile dds_voice	voices[DDS_VOICES];
+static volatile uint16_t	cycles_max[DDS_VOICES + 1];	// Largest cost of the sample interrupt per number of sounding voices
+static volatile uint16_t	clipped = 0;				// Saturated samples
+
+// Envelope shape: steps per control tick (full scale change), sustain level //
+static volatile uint16_t	attack_step;
+static volatile uint16_t	decay_step;
+static volatile uint16_t	release_step;
+static volatile uint16_t	sustain_level;
+static uint8_t				control_slot = 0;		// Sample within the control period (voice of the envelope step)
+
+// Voice allocation (only used outside the sample interrupt) //
+static uint8_t	voice_key[DDS_VOICES];		// Key of the voice or DDS_NO_KEY
+static uint8_t	voice_start[DDS_VOICES];	// Value of note_count when the voice was started
+static uint8_t	note_count = 0;				// Started notes (wraps around, only differences are used)
+
+// One period of the sine, amplitude 127 (index = upper 8 bits of the phase) //
+static const int8_t sine[256] = {
+	   0,    3,    6,    9,   12,   16,   19,   22,   25,   28,   31,   34,   37,   40,   43,   46,
+	  49,   51,   54,   57,   60,   63,   65,   68,   71,   73,   76,   78,   81,   83,   85,   88,
+	  90,   92,   94,   96,   98,  100,  102,  104,  106,  107,  109,  111,  112,  113,  115,  116,
+	 117,  118,  120,  121,  122,  122,  123,  124,  125,  125,  126,  126,  126,  127,  127,  127,
+	 127,  127,  127,  127,  126,  126,  126,  125,  125,  124,  123,  122,  122,  121,  120,  118,
+	 117,  116,  115,  113,  112,  111,  109,  107,  106,  104,  102,  100,   98,   96,   94,   92,
+	  90,   88,   85,   83,   81,   78,   76,   73,   71,   68,   65,   63,   60,   57,   54,   51,
+	  49,   46,   43,   40,   37,   34,   31,   28,   25,   22,   19,   16,   12,    9,    6,    3,
+	   0,   -3,   -6,   -9,  -12,  -16,  -19,  -22,  -25,  -28,  -31,  -34,  -37,  -40,  -43,  -46,
+	 -49,  -51,  -54,  -57,  -60,  -63,  -65,  -68,  -71,  -73,  -76,  -78,  -81,  -83,  -85,  -88,
+	 -90,  -92,  -94,  -96,  -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+	-117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+	-127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+	-117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100,  -98,  -96,  -94,  -92,
+	 -90,  -88,  -85,  -83,  -81,  -78,  -76,  -73,  -71,  -68,  -65,  -63,  -60,  -57,  -54,  -51,
+	 -49,  -46,  -43,  -40,  -37,  -34,  -31,  -28,  -25,  -22,  -19,  -16,  -12,   -9,   -6,   -3
+};
+
+
+// PRIVATE FUNCTIONS //
+/*
+*	Envelope steps per control tick for a full scale change in a given time.
+*
+*	@param ms Time in ms (0: one control tick)
+*	@return uint16_t Step (at least 1)
+*/
+static uint16_t envelope_step(uint16_t ms) {
+	uint32_t ticks = (static_cast<uint32_t>(ms) * DDS_CONTROL_RATE + 500) / 1000;
+	if (ticks == 0)
+		ticks = 1;
+	uint32_t step = DDS_ENVELOPE_MAX / ticks;
+	return static_cast<uint16_t>(step == 0 ? 1 : step);
+}
+
+/*
+*	Voice for a new note: the voice already playing the key, else a silent voice,
+*	else the releasing voice started longest ago, else the voice started longest ago (stolen).
+*
+*	@param key Key number
+*	@return uint8_t Voice 0 ... DDS_VOICES - 1
+*/
+static uint8_t allocate_voice(uint8_t key) {
+	uint8_t oldest = 0;
+	uint16_t oldest_age = 0;
+
+	for (uint8_t i = 0; i < DDS_VOICES; i++) {
+		if (voice_key[i] == key && voices[i].stage != DDS_STAGE_OFF && voices[i].stage != DDS_STAGE_RELEASE)
+			return i;
+	}
+	for (uint8_t i = 0; i < DDS_VOICES; i++) {
+		if (voices[i].stage == DDS_STAGE_OFF)
+			return i;
+
+		// Releasing voices are older than every held one //
+		uint16_t age = static_cast<uint8_t>(note_count - voice_start[i]);
+		if (voices[i].stage == DDS_STAGE_RELEASE)
+			age += 0x100;
+		if (age >= oldest_age) {
+			oldest_age = age;
+			oldest = i;
+		}
+	}
+	return oldest;
+}
+
+/*
+*	Starts the attack of a voice from its current envelope (no jump on a stolen voice).
+*	Interrupts disabled.
+*/
+static void start_voice(uint8_t voice, uint32_t tuning_word, uint8_t level) {
+	voices[voice].tuning = tuning_word;
+	voices[voice].level = level;
+	voices[voice].stage = DDS_STAGE_ATTACK;
+}
+
+/*
+*	Advances the envelope of one voice by one control tick and updates its gain.
+*	Called from the sample interrupt.
+*/
+static inline void envelope_tick(uint8_t voice) {
+	volatile dds_voice& v = voices[voice];
+	uint16_t envelope = v.envelope;
+
+	switch (v.stage) {
+	case DDS_STAGE_ATTACK:
+		if (envelope >= DDS_ENVELOPE_MAX - attack_step) {
+			envelope = DDS_ENVELOPE_MAX;
+			v.stage = DDS_STAGE_DECAY;
+		} else {
+			envelope += attack_step;
+		}
+		break;
+	case DDS_STAGE_DECAY:
+		if (envelope <= sustain_level + decay_step) {
+			envelope = sustain_level;
+			v.stage = DDS_STAGE_SUSTAIN;
+		} else {
+			envelope -= decay_step;
+		}
+		break;
+	case DDS_STAGE_RELEASE:
+		if (envelope <= release_step) {
+			envelope = 0;
+			v.stage = DDS_STAGE_OFF;
+		} else {
+			envelope -= release_step;
+		}
+		break;
+	default:	// DDS_STAGE_SUSTAIN, DDS_STAGE_OFF: constant
+		return;
+	}
+
+	v.envelope = envelope;
+	v.gain = static_cast<uint8_t>((v.level * static_cast<uint8_t>(envelope >> 8) + 0xFF) >> 8);
+}
+
+
+// PUBLIC FUNCTIONS //
+/*
+*	Initializes DAC0 (2.048V reference, output on PD6) and starts the sample clock
+*	(TCA0 overflow at DDS_SAMPLE_RATE). All voices are silent.
+*
+*	@param None
+*	@return None
+*/
+void dds_init() {
+	for (uint8_t i = 0; i < DDS_VOICES; i++) {
+		voices[i].phase = 0;
+		voices[i].tuning = 0;
+		voices[i].envelope = 0;
+		voices[i].stage = DDS_STAGE_OFF;
+		voices[i].level = 0;
+		voices[i].gain = 0;
+		voice_key[i] = DDS_NO_KEY;
+	}
+	dds_setEnvelope(DDS_ATTACK_MS, DDS_DECAY_MS, DDS_SUSTAIN_LEVEL, DDS_RELEASE_MS);
+	for (uint8_t i = 0; i <= DDS_VOICES; i++)
+		cycles_max[i] = 0;
+	clipped = 0;
+
+	VREF.DAC0REF = VREF_REFSEL_2V048_gc;
+	DAC0.DATA = static_cast<uint16_t>(DDS_DAC_MID << DDS_DAC_SHIFT);
+	DAC0.CTRLA = DAC_OUTEN_bm | DAC_ENABLE_bm;
+
+	DDS_TIMER.CTRLA = 0;
+	DDS_TIMER.CNT = 0;
+	DDS_TIMER.PER = static_cast<uint16_t>(F_CPU / DDS_SAMPLE_RATE - 1);
+	DDS_TIMER.INTCTRL = TCA_SINGLE_OVF_bm;
+	DDS_TIMER.CTRLA = TCA_SINGLE_CLKSEL_DIV1_gc | TCA_SINGLE_ENABLE_bm;
+}
+
+/*
+*	Starts or retunes a voice with the attack of the envelope. The phase is not reset,
+*	the waveform continues without a jump.
+*
+*	@param voice 0 ... DDS_VOICES - 1
+*	@param tuning_word Phase increment per sample (dds_tuning_word())
+*	@param level Volume 1 ... DDS_LEVEL_MAX (0 releases the voice)
+*	@return None
+*/
+void dds_play(uint8_t voice, uint32_t tuning_word, uint8_t level) {
+	if (voice >= DDS_VOICES)
+		return;
+	if (level == 0) {
+		dds_stop(voice);
+		return;
+	}
+
+	uint8_t sreg = SREG;	// 32-bit tuning word is read by the sample interrupt
+	cli();
+	start_voice(voice, tuning_word, level);
+	voice_key[voice] = DDS_NO_KEY;
+	SREG = sreg;
+}
+
+/*
+*	Ends the note of a voice: the envelope fades out with the release time.
+*
+*	@param voice 0 ... DDS_VOICES - 1
+*	@return None
+*/
+void dds_stop(uint8_t voice) {
+	if (voice >= DDS_VOICES)
+		return;
+
+	uint8_t sreg = SREG;
+	cli();
+	if (voices[voice].stage != DDS_STAGE_OFF)
+		voices[voice].stage = DDS_STAGE_RELEASE;
+	SREG = sreg;
+}
+
+/*
+*	@param voice 0 ... DDS_VOICES - 1
+*	@return bool true if the voice sounds (also while it fades out)
+*/
+bool dds_playing(uint8_t voice) {
+	return voice < DDS_VOICES && voices[voice].stage != DDS_STAGE_OFF;
+}
+
+/*
+*	Sets the envelope of all voices (also of the sounding ones). Times are for a change over
+*	the full range, resolution 1 / DDS_CONTROL_RATE (2ms).
+*
+*	@param attack_ms Rise from silence to full volume
+*	@param decay_ms Fall from full volume to silence (stops at the sustain level)
+*	@param sustain Level while the note is held, 0 ... 255 (255: no decay)
+*	@param release_ms Fall from full volume to silence after the note ended
+*	@return None
+*/
+void dds_setEnvelope(uint16_t attack_ms, uint16_t decay_ms, uint8_t sustain, uint16_t release_ms) {
+	uint16_t attack = envelope_step(attack_ms);		// Divisions here, not in the interrupt
+	uint16_t decay = envelope_step(decay_ms);
+	uint16_t release = envelope_step(release_ms);
+
+	uint8_t sreg = SREG;
+	cli();
+	attack_step = attack;
+	decay_step = decay;
+	release_step = release;
+	sustain_level = static_cast<uint16_t>(sustain << 8 | sustain);
+	SREG = sreg;
+}
+
+/*
+*	Starts a note for a key on a free voice. If the key already sounds, its voice is retuned;
+*	if all voices are busy, the voice started longest ago is stolen.
+*
+*	@param key Key number (0 ... 254), e.g. the index of the button
+*	@param tuning_word Phase increment per sample (dds_tuning_word())
+*	@param level Volume 1 ... DDS_LEVEL_MAX
+*	@return uint8_t Voice that plays the note (DDS_NO_VOICE for level 0)
+*/
+uint8_t dds_noteOn(uint8_t key, uint32_t tuning_word, uint8_t level) {
+	if (level == 0)
+		return DDS_NO_VOICE;
+
+	uint8_t sreg = SREG;	// Called from the main loop and from button interrupts
+	cli();
+	uint8_t voice = allocate_voice(key);
+	start_voice(voice, tuning_word, level);
+	voice_key[voice] = key;
+	voice_start[voice] = note_count++;
+	SREG = sreg;
+	return voice;
+}
+
+/*
+*	Ends the note of a key, its voice fades out with the release time
+*	(nothing happens if the voice was stolen meanwhile).
+*
+*	@param key Key number of dds_noteOn()
+*	@return None
+*/
+void dds_noteOff(uint8_t key) {
+	uint8_t sreg = SREG;
+	cli();
+	for (uint8_t i = 0; i < DDS_VOICES; i++) {
+		if (voice_key[i] == key) {
+			if (voices[i].stage != DDS_STAGE_OFF)
+				voices[i].stage = DDS_STAGE_RELEASE;
+			voice_key[i] = DDS_NO_KEY;
+		}
+	}
+	SREG = sreg;
+}
+
+/*
+*	@param None
+*	@return uint8_t Number of sounding voices (including fading out ones)
+*/
+uint8_t dds_voicesActive() {
+	uint8_t active = 0;
+	for (uint8_t i = 0; i < DDS_VOICES; i++) {
+		if (voices[i].stage != DDS_STAGE_OFF)
+			active++;
+	}
+	return active;
+}
+
+/*
+*	Largest cost of the sample interrupt with a given number of sounding voices since the
+*	last call. Counted from the timer overflow to the end of the interrupt, so interrupt latency,
+*	entry (saving the registers) and exit are included: the full cost of one sample period.
+*	Headroom = F_CPU / DDS_SAMPLE_RATE - cycles.
+*
+*	@param active Number of sounding voices 0 ... DDS_VOICES
+*	@return uint16_t CPU cycles per sample (exit estimated with DDS_CYCLES_EXIT), 0 if not measured yet
+*/
+uint16_t dds_cycles(uint8_t active) {
+	if (active > DDS_VOICES)
+		return 0;
+
+	uint8_t sreg = SREG;
+	cli();
+	uint16_t cycles = cycles_max[active];
+	cycles_max[active] = 0;
+	SREG = sreg;
+	return cycles;
+}
+
+/*
+*	Samples limited to the DAC range since the last call. Many clipped samples: lower
+*	DDS_MIX_GAIN or the levels.
+*
+*	@param None
+*	@return uint16_t Saturated samples
+*/
+uint16_t dds_clipped() {
+	uint8_t sreg = SREG;
+	cli();
+	uint16_t count = clipped;
+	clipped = 0;
+	SREG = sreg;
+	return count;
+}
+
+// INTERRUPTS //
+/*
+*	Sample clock: advance every sounding voice, sum the sine values weighted with the gain
+*	of the voice, saturate the sum to the DAC range and output it. Every DDS_CONTROL_DIVIDER
+*	samples each voice gets one envelope step (one voice per sample).
+*/
+ISR(TCA0_OVF_vect) {
+	int16_t mix = 0;
+	uint8_t active = 0;
+
+	for (uint8_t i = 0; i < DDS_VOICES; i++) {
+		if (voices[i].stage == DDS_STAGE_OFF)
+			continue;
+
+		uint32_t phase = voices[i].phase + voices[i].tuning;
+		voices[i].phase = phase;
+		mix += static_cast<int16_t>(sine[static_cast<uint8_t>(phase >> 24)] * voices[i].gain) >> 8;	// -127 ... 126
+		active++;
+	}
+
+	mix *= DDS_MIX_GAIN;
+	if (mix > DDS_MIX_MAX) {
+		mix = DDS_MIX_MAX;
+		clipped++;
+	} else if (mix < DDS_MIX_MIN) {
+		mix = DDS_MIX_MIN;
+		clipped++;
+	}
+	DAC0.DATA = static_cast<uint16_t>((DDS_DAC_MID + mix) << DDS_DAC_SHIFT);
+	DDS_TIMER.INTFLAGS = TCA_SINGLE_OVF_bm;
+
+	// Control rate: envelope of one voice, after the DAC write (no jitter on the output) //
+	if (control_slot < DDS_VOICES)
+		envelope_tick(control_slot);
+	if (++control_slot == DDS_CONTROL_DIVIDER)
+		control_slot = 0;
+
+	// Cost since the overflow: TCA0 counts CPU cycles (DIV1) from 0 at the overflow //
+	uint16_t cycles = static_cast<uint16_t>(DDS_TIMER.CNT + DDS_CYCLES_EXIT);
+	if (DDS_TIMER.INTFLAGS & TCA_SINGLE_OVF_bm)	// Longer than one sample period: CNT wrapped
+		cycles += static_cast<uint16_t>(F_CPU / DDS_SAMPLE_RATE);
+	if (cycles > cycles_max[active])
+		cycles_max[active] = cycles;
+}
@@ -0,0 +1,141 @@
+/*
+ ***********************************************************************************
+ * @file:   DDS_Tone.h
+ * @date:   16.10.2026
+ *
+ * Tone generation by direct digital synthesis (DDS) on DAC0. TCA0 calls the sample
+ * interrupt at the fixed rate DDS_SAMPLE_RATE, independent of the pitch. Every voice has a
+ * 32-bit phase accumulator: per sample the tuning word of the voice is added to it and the
+ * upper 8 bits select the value of a 256-entry sine table.
+ *
+ *   frequency = tuning word * DDS_SAMPLE_RATE / 2^32
+ *
+ * At 8kHz one step of the tuning word is 1.9uHz, every note is hit to far below one cent
+ * (former method: the timer period was truncated to whole CPU cycles per table step, e.g.
+ * main3.cpp played 440Hz as 437.1Hz = -12 cent, and the sample rate changed with the pitch).
+ * dds_tuning_word() is constexpr, tuning words of constant frequencies cost no run time.
+ *
+ * Polyphony: up to DDS_VOICES voices sound at the same time. dds_noteOn() / dds_noteOff()
+ * allocate the voices by a key number (e.g. the button): a free voice is taken, if all are
+ * busy the voice started longest ago is stolen. The voices are summed and scaled by
+ * DDS_MIX_GAIN, the sum is saturated to the 10-bit DAC range (no wrap-around on peaks).
+ *
+ * Envelope: every voice has an ADSR envelope (attack, decay, sustain, release) in 16-bit
+ * fixed point. Notes fade in on dds_play() / dds_noteOn() and fade out on dds_stop() /
+ * dds_noteOff(), no click at start and end. The envelopes run at the control rate
+ * DDS_CONTROL_RATE (DDS_SAMPLE_RATE / DDS_CONTROL_DIVIDER): the sample interrupt advances
+ * the envelope of at most one voice per sample (round robin) and turns it into the 8-bit
+ * gain of the voice, the sample path keeps its single 8x8 multiplication per voice.
+ * The shape is set with dds_setEnvelope() and used by all voices.
+ *
+ * The cost of the interrupt only depends on the number of sounding voices, not on the
+ * pitch. dds_cycles(n) reports the largest measured cost with n sounding voices, counted
+ * from the timer overflow (including interrupt entry and exit), the budget is
+ * F_CPU / DDS_SAMPLE_RATE cycles per sample
+ * (500 at 4MHz / 8kHz). AVR_ADC_and_Audio_Projects/main10.cpp shows the headroom.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Connections:
+  DAC0 output - PD6 (reference 2.048V)
+  Uses TCA0 (overflow interrupt) as sample clock.
+
+  Usage:
+  1. Call dds_init(), then sei().
+  2. dds_play(0, dds_tuning_word(440)) starts voice 0 with 440Hz,
+     dds_play(0, dds_tuning_word(44000, 100)) with 440.00Hz,
+     dds_play(0, dds_tuning_hz(frequency)) for a frequency known only at run time.
+  3. dds_stop(0) releases the voice, its phase keeps running (no click on the next note).
+  Optional: dds_setEnvelope(5, 300, 128, 200) for a plucked sound (ms, ms, level, ms).
+  Keyboard: dds_noteOn(key, dds_tuning_word(note)) on press, dds_noteOff(key) on release.
+*/
+
+
+#ifndef DDS_TONE_H_
+#define DDS_TONE_H_
+
+// INCLUDES //
+#include <avr/io.h>
+#include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
+
+
+// DEFINES //
+#ifndef DDS_SAMPLE_RATE
+#define DDS_SAMPLE_RATE		8000UL	// Samples per second (F_CPU must be a multiple of it)
+#endif
+
+#ifndef DDS_VOICES
+#define DDS_VOICES			4		// Voices that can sound at the same time
+#endif
+
+#ifndef DDS_MIX_GAIN
+#define DDS_MIX_GAIN		2		// One voice at full volume: +-2 * 127 of +-512 (two voices fill the DAC range)
+#endif
+
+#ifndef DDS_CONTROL_DIVIDER
+#define DDS_CONTROL_DIVIDER	16		// Samples per envelope step of a voice (at least DDS_VOICES)
+#endif
+
+#define DDS_CONTROL_RATE	(DDS_SAMPLE_RATE / DDS_CONTROL_DIVIDER)	// Envelope steps per second (500Hz: 2ms)
+
+#ifndef DDS_ATTACK_MS
+#define DDS_ATTACK_MS		5		// Default envelope after dds_init(): short fade in ...
+#endif
+
+#ifndef DDS_DECAY_MS
+#define DDS_DECAY_MS		0
+#endif
+
+#ifndef DDS_SUSTAIN_LEVEL
+#define DDS_SUSTAIN_LEVEL	255		// ... hold at full volume ...
+#endif
+
+#ifndef DDS_RELEASE_MS
+#define DDS_RELEASE_MS		30		// ... short fade out (organ-like, without clicks)
+#endif
+
+#define DDS_LEVEL_MAX		255		// Full volume of one voice
+#define DDS_NO_VOICE		0xFF	// Return value of dds_noteOn() without a voice
+
+
+// FUNCTION DECLARATIONS //
+/*
+*	Tuning word of a frequency (rounded), meant for constants: evaluated by the compiler.
+*
+*	@param frequency Frequency in 1 / divisor Hz
+*	@param divisor e.g. 100 for a frequency in 0.01Hz (default 1: whole Hz)
+*	@return uint32_t Phase increment per sample
+*/
+constexpr uint32_t dds_tuning_word(uint32_t frequency, uint16_t divisor = 1) {
+	return static_cast<uint32_t>(((static_cast<uint64_t>(frequency) << 32) + static_cast<uint64_t>(divisor) * DDS_SAMPLE_RATE / 2)
+		/ (static_cast<uint64_t>(divisor) * DDS_SAMPLE_RATE));
+}
+
+/*
+*	Tuning word of a whole-Hz frequency at run time (one 32-bit multiplication instead of the
+*	64-bit division of dds_tuning_word(); deviation < 0.001 cent).
+*
+*	@param frequency Frequency in Hz (below DDS_SAMPLE_RATE / 2)
+*	@return uint32_t Phase increment per sample
+*/
+static inline uint32_t dds_tuning_hz(uint16_t frequency) {
+	return frequency * dds_tuning_word(1);
+}
+
+void dds_init(); // Removed void from parameter list for C++
+void dds_play(uint8_t voice, uint32_t tuning_word, uint8_t level = DDS_LEVEL_MAX);
+void dds_stop(uint8_t voice);
+bool dds_playing(uint8_t voice);
+void dds_setEnvelope(uint16_t attack_ms, uint16_t decay_ms, uint8_t sustain, uint16_t release_ms);
+uint8_t dds_noteOn(uint8_t key, uint32_t tuning_word, uint8_t level = DDS_LEVEL_MAX);
+void dds_noteOff(uint8_t key);
+uint8_t dds_voicesActive(); // Removed void from parameter list for C++
+uint16_t dds_cycles(uint8_t active);
+uint16_t dds_clipped(); // Removed void from parameter list for C++
+
+#endif /* DDS_TONE_H_ */
@@ -29,10 +29,15 @@
 // INCLUDES //
 #define F_CPU 4000000	// Peripheral Clock Speed for correct delay functionality
 #include <util/delay.h>
+#include <avr/interrupt.h>
 #include <I2C_LCD.h>
 
 // DEFINES //
-#define DISPLAY_ADDRESS 0x27	// Only applies if Pins A1, A2 and A3 of the HW-061 are open (connected to Vdd)
+#define DISPLAY_ADDRESS 0x27	// Default display, only applies if Pins A1, A2 and A3 of the HW-061 are open (connected to Vdd)
+
+#ifndef LCD_I2C_MODE
+#define LCD_I2C_MODE NORMAL_MODE	// Bus speed used by lcd_init() (the PCF8574 is specified for 100kHz)
+#endif
 
 #define RS	0b00000001		// RS Enable
 #define RW	0b00000010		// RW Enable
@@ -47,50 +52,202 @@
 #define D6	0b01000000		// D6 Enable
 #define D7	0b10000000		// D7 Enable
 
+/*
+	Every HD44780 byte is sent as 4 expander states (E high / E low for the high and the low nibble).
+	All states of a command or a string are collected in one buffer and sent as a single I2C transaction,
+	instead of one START + address + STOP per state with _delay_us() padding in between.
+	Modelled cost of one 16 character line at 100kHz:
+	- before: 64 transactions, 128 bytes on the bus (address + state), ~14.4ms (~190us bus + ~35us delay per state)
+	- after:   1 transaction,   65 bytes on the bus, ~5.9ms
+	Each display has two stream buffers: one is on the bus (I2C queue) while the next one is filled.
+*/
+#define LCD_EXECUTION_TIME_US	41		// Execution time of all instructions except clear / return home
+#define LCD_FLUSH_MAX_GAP		1		// Unchanged cells that lcd_flush() rewrites instead of moving the cursor (both cost one instruction)
+#define CURSOR_UNKNOWN			-1		// Cursor is off-screen or its position is not known
+#define LCD_BUSY_MAX_POLLS		50		// Busy flag reads before lcd_clear() gives up in LCD_WAIT_BUSY_FLAG mode
+#define LCD_GLYPH_FALLBACK		' '		// Replaces cells whose glyph had to be evicted
+#define LCD_BAR_FULL			0xFF	// Full block in the character ROM (A00)
+
 // VARIABLES //
-volatile i2c_status status = SUCCESS;
-volatile uint8_t display_state = 0x00;
+static lcd_display default_display;			// 16x2 at DISPLAY_ADDRESS, used if no other display is selected
+static lcd_display* lcd = &default_display;	// Display the functions work on
+static lcd_display* displays[LCD_MAX_DISPLAYS];	// Initialized displays, flushed by lcd_flushAll()
+static uint8_t display_count = 0;
+static lcd_wait_mode wait_mode = LCD_WAIT_FIXED;	// How to wait for clear / return home
+
+/*
+	DDRAM address of the first character of each row. 2 row displays start the second row at 0x40;
+	a 20x4 display continues rows 0 and 1 with rows 2 and 3.
+	In 2 line mode the address counter runs through 0x00 - 0x27 and 0x40 - 0x67 and then wraps,
+	the driver mirrors it as one array of 80 characters (see lcd_cell()).
+*/
+static const uint8_t row_offset_two_rows[] = {0x00, 0x40};
+static const uint8_t row_offset_20x4[] = {0x00, 0x40, 0x14, 0x54};
+
+/*
+	Partial blocks for lcd_bufferPutBar(), 1 to 4 of 5 columns filled.
+	The full block is in the character ROM and needs no slot.
+*/
+static const uint8_t bar_glyph[4][8] = {
+	{0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10},
+	{0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18},
+	{0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C, 0x1C},
+	{0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E, 0x1E}
+};
+
+static volatile uint8_t pending_events = 0;	// Events posted by lcd_post(), not yet rendered
+static lcd_renderer renderer = 0;			// Draws the screen buffer for the posted events
+
+/*
+	The controller needs LCD_EXECUTION_TIME_US after the last E pulse of an instruction before it accepts the next one.
+	Within a stream, the next falling edge of E follows 2 states later (one state = 9 SCL periods). At high bus speeds
+	that is too fast, so additional E low states are appended to each instruction to fill the execution time.
+*/
+static constexpr uint32_t bus_frequency = (LCD_I2C_MODE == FAST_MODE_PLUS) ? 1000000UL : ((LCD_I2C_MODE == FAST_MODE) ? 400000UL : 100000UL);
+static constexpr uint8_t states_per_execution = static_cast<uint8_t>((LCD_EXECUTION_TIME_US * bus_frequency + 9000000UL - 1) / 9000000UL);
+static constexpr uint8_t settle_states = (states_per_execution > 2) ? static_cast<uint8_t>(states_per_execution - 2) : 0;
 
 // PRIVATE FUNCTION DECLARATIONS //
 static i2c_status lcd_write_data(uint8_t data, bool rs, bool rw, bool init);
+static i2c_status lcd_stream_flush(); // Removed void from parameter list for C++
+static i2c_status lcd_stream_wait(uint8_t index);
+static i2c_status lcd_stream_sync(); // Removed void from parameter list for C++
+static uint8_t lcd_cell(uint8_t x, uint8_t y);
+static i2c_status lcd_move_address(uint8_t position);
+static void lcd_track_char(char character);
+static i2c_status lcd_wait_long_instruction(); // Removed void from parameter list for C++
+static i2c_status lcd_flush_begin(); // Removed void from parameter list for C++
+static i2c_status lcd_flush_step(bool* done);
+static i2c_status lcd_flush_end(i2c_status result);
+static void lcd_glyph_touch(uint8_t slot);
+static uint8_t lcd_glyph_evict(); // Removed void from parameter list for C++
+static i2c_status lcd_glyph_upload(); // Removed void from parameter list for C++
 
 // PUBLIC FUNCTIONS //
 
 /*
-	Initializes the LCD-Display by sending the required Initialization Sequence and 
+	Configures a display. Nothing is sent: select the display with lcd_select() and call lcd_init().
+	The display object must stay valid as long as it is used (e.g. a global variable).
+
+	@param display Display to configure.
+	@param address 7-Bit address of the PCF8574 (0x20 - 0x27, set with A0 - A2 of the HW-061).
+	@param geometry LCD_16X2, LCD_20X4 or LCD_40X2.
+	@return NONE
+*/
+void lcd_setup(lcd_display* display, uint8_t address, lcd_geometry geometry) {
+	display->address = address;
+	switch (geometry) {
+		case LCD_20X4:	display->columns = 20;	display->rows = 4;	display->row_offset = row_offset_20x4;		break;
+		case LCD_40X2:	display->columns = 40;	display->rows = 2;	display->row_offset = row_offset_two_rows;	break;
+		default:		display->columns = 16;	display->rows = 2;	display->row_offset = row_offset_two_rows;	break;
+	}
+
+	display->display_state = 0x00;
+	display->shown_valid = false;
+	display->cursor = CURSOR_UNKNOWN;
+	display->cursor_step = 1;
+	display->shift = 0;
+	display->stream_index = 0;
+	display->stream_length = 0;
+	display->in_flight = 0;
+	display->submitted = 0;
+	display->batch_depth = 0;
+
+	// CGRAM content is undefined after power-on //
+	for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++) {
+		display->glyph_bitmap[slot] = 0;
+		display->glyph_order[slot] = slot;
+	}
+	display->glyph_pending = 0;
+
+	for (uint8_t i = 0; i < LCD_DDRAM_SIZE; i++)
+		display->shadow[i] = ' ';
+}
+
+/*
+	Selects the display all other functions work on.
+
+	@param display Display configured with lcd_setup(), or 0 for the default display (16x2 at 0x27).
+	@return NONE
+*/
+void lcd_select(lcd_display* display) {
+	lcd = (display != 0) ? display : &default_display;
+}
+
+/*
+	@param NONE
+	@return lcd_display* The selected display.
+*/
+lcd_display* lcd_selected() { // Removed void from parameter list for C++
+	return lcd;
+}
+
+/*
+	@param NONE
+	@return uint8_t Characters per row of the selected display.
+*/
+uint8_t lcd_columns() { // Removed void from parameter list for C++
+	return lcd->columns;
+}
+
+/*
+	@param NONE
+	@return uint8_t Rows of the selected display.
+*/
+uint8_t lcd_rows() { // Removed void from parameter list for C++
+	return lcd->rows;
+}
+
+/*
+	Initializes the selected LCD-Display by sending the required Initialization Sequence and
 	following commands:
 	- Run in 4-Bit Mode
-	- 2 Lines, 5x8 Font Size
+	- 2 Lines, 5x8 Font Size (4 row displays are 2 line displays for the controller)
 	- Enable the display (Show written characters)
 	- Clear the display (Remove all written characters)
 	- Set the cursor to move from left to right (after each write)
 	- Enables the backlight
+	The default display is configured as 16x2 at address 0x27 if it has not been set up.
 	
 	@param NONE
 	@return i2c_status SUCCESS if operation succeeded. Any other: See AVR128DB48_I2C Module.
 */
 i2c_status lcd_init() { // Removed void from parameter list for C++
 	
-	i2c_init();				// Init I2C-Bus
+	i2c_status status;
+
+	if (lcd == &default_display && default_display.columns == 0)
+		lcd_setup(&default_display, DISPLAY_ADDRESS, LCD_16X2);
+
+	status = i2c_init(LCD_I2C_MODE);	// Init I2C-Bus
+	if(status != SUCCESS)
+		return status;
+	
+	// Register for lcd_flushAll() //
+	uint8_t i = 0;
+	while (i < display_count && displays[i] != lcd)
+		i++;
+	if (i == display_count && display_count < LCD_MAX_DISPLAYS)
+		displays[display_count++] = lcd;
 		
-	status = i2c_write_byte(DISPLAY_ADDRESS, 0x00);	// Clear I2C I/O-Expander
+	status = i2c_write_byte(lcd->address, 0x00);	// Clear I2C I/O-Expander
 	if(status != SUCCESS)
 		return status;
 	
 	_delay_ms(50);			// Waiting phase after power-on of LCD
 	
 	// 4-Bit Initialization sequence (Figure 24 of the HD44780 Datasheet) //
-	status = lcd_write_data(static_cast<uint8_t>(D4 + D5), true, false, true); // Cast to uint8_t
+	status = lcd_write_data(static_cast<uint8_t>(D4 + D5), false, false, true); // Cast to uint8_t
 	if (status != SUCCESS)
 		return status;
 	_delay_us(5000);
 	
-	status = lcd_write_data(static_cast<uint8_t>(D4 + D5), true, false, true); // Cast to uint8_t
+	status = lcd_write_data(static_cast<uint8_t>(D4 + D5), false, false, true); // Cast to uint8_t
 	if (status != SUCCESS)
 		return status;
 	_delay_us(110);
 	
-	status = lcd_write_data(static_cast<uint8_t>(D4 + D5), true, false, true); // Cast to uint8_t
+	status = lcd_write_data(static_cast<uint8_t>(D4 + D5), false, false, true); // Cast to uint8_t
 	if (status != SUCCESS)
 		return status;
 	_delay_us(50);
@@ -113,6 +270,7 @@ i2c_status lcd_init() { // Removed void from parameter list for C++
 	status = lcd_clear();			// Clear Display
 	if(status != SUCCESS)
 		return status;
+	lcd_bufferClear();
 	
 	status = lcd_leftToRight();		// Cursor moves from left to right
 	if(status != SUCCESS)
@@ -131,6 +289,7 @@ i2c_status lcd_init() { // Removed void from parameter list for C++
 	@return i2c_status SUCCESS if operation succeeded. Any other: See AVR128DB48_I2C Module.
 */
 i2c_status lcd_enable(bool enable) {
+	i2c_status status;
 	if (enable) {
 		status = lcd_write_data(static_cast<uint8_t>(D2 + D3), false, false, false); // Cast to uint8_t
 		if (status != SUCCESS)	// Enable Display
@@ -141,7 +300,6 @@ i2c_status lcd_enable(bool enable) {
 		if (status != SUCCESS)			// Disable Display
 			return status;
 	}
-	_delay_us(37);
 	
 	return SUCCESS;
 }
@@ -153,19 +311,19 @@ i2c_status lcd_enable(bool enable) {
 	@return i2c_status SUCCESS if operation succeeded. Any other: See AVR128DB48_I2C Module.
 */
 i2c_status lcd_backlight(bool enable) {
+	i2c_status status;
 	if (enable) {
-		display_state |= BT;
+		lcd->display_state |= BT;
 		status = lcd_write_data(static_cast<uint8_t>(D2 + D3), false, false, false); // Cast to uint8_t
 		if (status != SUCCESS)			// Enable Display
 			return status;
 	}
 	else {
-		display_state &= static_cast<uint8_t>(~BT); // Cast to uint8_t
+		lcd->display_state &= static_cast<uint8_t>(~BT); // Cast to uint8_t
 		status = lcd_write_data(D3, false, false, false);			// Disable Display
 		if (status != SUCCESS)			// Disable Display
 			return status;
 	}
-	_delay_us(37);
 		
 	return SUCCESS;
 }
@@ -179,37 +337,42 @@ i2c_status lcd_backlight(bool enable) {
 i2c_status lcd_clear() { // Removed void from parameter list for C++
 	if (lcd_write_data(D0, false, false, false) != SUCCESS)				// Clear Display
 		return ERROR;
-	_delay_us(1600);
+	if (lcd_stream_sync() != SUCCESS)									// Send now, also inside a batch
+		return ERROR;
+	if (lcd_wait_long_instruction() != SUCCESS)
+		return ERROR;
+	
+	// Display is blank, not shifted and the cursor is home, moving from left to right //
+	for (uint8_t i = 0; i < LCD_DDRAM_SIZE; i++)
+		lcd->shown[i] = ' ';
+	lcd->shown_valid = true;
+	lcd->cursor = 0;
+	lcd->cursor_step = 1;
+	lcd->shift = 0;
 	
 	return SUCCESS;
 }
 
-
-static const uint8_t row_offset[] = {0x00, 0x40};	// Offset of each line in character memory
-
 /*
 	Moves the cursor to the specified position on the display.
 	Any next write will occur at this position and possibly overwrite
 	characters that have been already written to this position.
+	The position is relative to the visible window (see lcd_scroll()).
 	
-	@param x A value from 0 to 15. Specifies the horizontal position (column).
-	@param y A value from 0 to 1. Specifies the vertical position (row).
+	@param x A value from 0 to columns - 1. Specifies the horizontal position (column).
+	@param y A value from 0 to rows - 1. Specifies the vertical position (row).
 	@return i2c_status SUCCESS if operation succeeded. Any other: See AVR128DB48_I2C Module.
 */
 i2c_status lcd_moveCursor(uint8_t x, uint8_t y) {
 	
 	// Constrain Columns //
-	if (x > 15)
-		x = 15;
+	if (x >= lcd->columns)
+		x = static_cast<uint8_t>(lcd->columns - 1);
 	// Constrain Rows //
-	if (y > 1)
-		y = 1;
+	if (y >= lcd->rows)
+		y = static_cast<uint8_t>(lcd->rows - 1);
 		
-	if (lcd_write_data(static_cast<uint8_t>(D7 + row_offset[y] + x), false, false, false) != SUCCESS)	// Move Cursor (DDRAM Address)
-		return ERROR;
-	_delay_us(37);
-	
-	return SUCCESS;
+	return lcd_move_address(lcd_cell(x, y));
 }
 
 /*
@@ -223,7 +386,7 @@ i2c_status lcd_moveCursor(uint8_t x, uint8_t y) {
 i2c_status lcd_putChar(char character) {
 	if (lcd_write_data(static_cast<uint8_t>(character), true, false, false) != SUCCESS) // Cast to uint8_t
 		return ERROR;
-	_delay_us(41);
+	lcd_track_char(character);
 		
 	return SUCCESS;
 }
@@ -232,20 +395,24 @@ i2c_status lcd_putChar(char character) {
 	Writes a specified string to the current cursor-position by writing each character one after another.
 	The cursor will be incremented or decremented (only the horizontal position) after each such write;
 	dependent on whether lcd_leftToRight() (=incrementing) or lcd_rightToLeft() (=decrementing) was last executed.
+	All characters are sent in one I2C transaction (up to 16 characters per transaction).
 	
-	@param character The ASCII-value of the character to be written.
+	@param string The null-terminated string to be written.
 	@return i2c_status SUCCESS if operation succeeded. Any other: See AVR128DB48_I2C Module.
 */
-i2c_status lcd_putString(char* string) {
+i2c_status lcd_putString(const char* string) {
+	lcd_beginBatch();
 	while(*string != 0x0) {		
-		if (lcd_write_data(static_cast<uint8_t>(*string), true, false, false) != SUCCESS) // Cast to uint8_t
+		if (lcd_write_data(static_cast<uint8_t>(*string), true, false, false) != SUCCESS) { // Cast to uint8_t
+			lcd_endBatch();
 			return ERROR;
+		}
+		lcd_track_char(*string);
 			
 		string++;
-		_delay_us(41);
 	}
 	
-	return SUCCESS;
+	return lcd_endBatch();
 }
 
 /*
@@ -258,7 +425,7 @@ i2c_status lcd_putString(char* string) {
 i2c_status lcd_leftToRight() { // Removed void from parameter list for C++
 	if (lcd_write_data(static_cast<uint8_t>(D1 + D2), false, false, false) != SUCCESS)	// Cursor moves from left to right
 		return ERROR;
-	_delay_us(37);
+	lcd->cursor_step = 1;
 	
 	return SUCCESS;
 }
@@ -273,12 +440,656 @@ i2c_status lcd_leftToRight() { // Removed void from parameter list for C++
 i2c_status lcd_rightToLeft() { // Removed void from parameter list for C++
 	if (lcd_write_data(D2, false, false, false) != SUCCESS)			// Cursor moves from right to left
 		return ERROR;
-	_delay_us(37);
+	lcd->cursor_step = -1;
+	
+	return SUCCESS;
+}
+
+/*
+	Starts a batch: following commands and characters are collected and sent together
+	in as few I2C transactions as possible when the outermost lcd_endBatch() is called.
+	lcd_clear() always sends immediately, because it has to wait for the display afterwards.
+	
+	@param NONE
+	@return NONE
+*/
+void lcd_beginBatch() { // Removed void from parameter list for C++
+	lcd->batch_depth++;
+}
+
+/*
+	Ends a batch started with lcd_beginBatch() and sends all collected data.
 	
+	@param NONE
+	@return i2c_status SUCCESS if operation succeeded. Any other: See AVR128DB48_I2C Module.
+*/
+i2c_status lcd_endBatch() { // Removed void from parameter list for C++
+	if (lcd->batch_depth > 0)
+		lcd->batch_depth--;
+	if (lcd->batch_depth > 0)
+		return SUCCESS;
+		
+	return lcd_stream_sync();
+}
+
+/*
+	Sends a raw HD44780 instruction (RS = 0), e.g. 0x02 for Return Home.
+	The driver does not track what the instruction does to the cursor or the display content:
+	call lcd_clear() or lcd_moveCursor() afterwards if it changed them.
+	
+	@param instruction Instruction byte (see HD44780 Datasheet, Table 6).
+	@return i2c_status SUCCESS if operation succeeded. Any other: See AVR128DB48_I2C Module.
+*/
+i2c_status lcd_command(uint8_t instruction) {
+	lcd->cursor = CURSOR_UNKNOWN;
+	return lcd_write_data(instruction, false, false, false);
+}
+
+/*
+	Selects how the driver waits for slow instructions (clear display).
+	LCD_WAIT_FIXED waits the worst-case time of the datasheet (1.6ms).
+	LCD_WAIT_BUSY_FLAG reads the busy flag and continues as soon as the controller is ready.
+	One busy flag read takes 5 short I2C transactions (~1.1ms at 100kHz), so polling only pays off
+	for slow instructions; all other instructions are already covered by the time on the bus.
+	
+	@param mode LCD_WAIT_FIXED or LCD_WAIT_BUSY_FLAG.
+	@return NONE
+*/
+void lcd_setWaitMode(lcd_wait_mode mode) {
+	wait_mode = mode;
+}
+
+/*
+	Reads the busy flag and the address counter of the HD44780.
+	The data lines of the PCF8574 are set high (input), RW is set and both nibbles
+	are clocked out with E; the expander port is read while E is high.
+	
+	@param value Bit 7: busy flag (1 = busy), Bits 6 - 0: address counter.
+	@return i2c_status SUCCESS if operation succeeded. Any other: See AVR128DB48_I2C Module.
+*/
+i2c_status lcd_readStatus(uint8_t* value) {
+	
+	// Send pending data first //
+	i2c_status status = lcd_stream_sync();
+	if (status != SUCCESS)
+		return status;
+	
+	uint8_t idle = static_cast<uint8_t>(D4 + D5 + D6 + D7 + RW + lcd->display_state);	// Data lines released, read mode
+	uint8_t strobe[] = {idle, static_cast<uint8_t>(idle + E)};
+	uint8_t high_nibble = 0;
+	uint8_t low_nibble = 0;
+	
+	// Bits 7 - 4 //
+	status = i2c_write(lcd->address, strobe, 2);
+	if (status == SUCCESS)
+		status = i2c_read_byte(lcd->address, &high_nibble);
+		
+	// Bits 3 - 0 //
+	if (status == SUCCESS)
+		status = i2c_write(lcd->address, strobe, 2);
+	if (status == SUCCESS)
+		status = i2c_read_byte(lcd->address, &low_nibble);
+		
+	// Pull enable low //
+	if (status == SUCCESS)
+		status = i2c_write_byte(lcd->address, idle);
+	if (status != SUCCESS)
+		return status;
+	
+	*value = static_cast<uint8_t>((high_nibble & 0xF0) | (low_nibble >> 4));
 	return SUCCESS;
 }
 
+/*
+	Clears the screen buffer (fills it with spaces).
+	Nothing is sent to the display until lcd_flush() is called, so unlike lcd_clear()
+	this neither blanks the display for a moment nor costs a 1.6ms delay.
+	Only the visible window is cleared, text scrolled out of view is kept.
+	
+	@param NONE
+	@return NONE
+*/
+void lcd_bufferClear() { // Removed void from parameter list for C++
+	for (uint8_t y = 0; y < lcd->rows; y++)
+		for (uint8_t x = 0; x < lcd->columns; x++)
+			lcd->shadow[lcd_cell(x, y)] = ' ';
+}
+
+/*
+	Writes a character to the screen buffer.
+	
+	@param x Column (0 to columns - 1), characters outside of the screen are ignored.
+	@param y Row (0 to rows - 1).
+	@param character The ASCII-value of the character to be written.
+	@return NONE
+*/
+void lcd_bufferPutChar(uint8_t x, uint8_t y, char character) {
+	if (x < lcd->columns && y < lcd->rows)
+		lcd->shadow[lcd_cell(x, y)] = character;
+}
+
+/*
+	Writes a string to the screen buffer, starting at the given position.
+	The string is cut off at the end of the row.
+	
+	@param x Column of the first character.
+	@param y Row.
+	@param string The null-terminated string to be written.
+	@return NONE
+*/
+void lcd_bufferPutString(uint8_t x, uint8_t y, const char* string) {
+	while (*string != 0x0 && x < lcd->columns) {
+		lcd_bufferPutChar(x++, y, *string++);
+	}
+}
+
+/*
+	Writes the whole 40 character DDRAM line of a row into the screen buffer, starting at the
+	first character of the row when the display is not scrolled. The rest of the line is filled
+	with spaces. Text longer than the display is brought into view with lcd_scroll().
+	On a 20x4 display rows 0 / 2 and 1 / 3 share a line, so the text continues in the other row.
+	
+	@param y Row.
+	@param string The null-terminated string to be written (up to 40 characters).
+	@return NONE
+*/
+void lcd_bufferPutLine(uint8_t y, const char* string) {
+	if (y >= lcd->rows)
+		return;
+	
+	uint8_t line = static_cast<uint8_t>((lcd->row_offset[y] & D6) ? LCD_LINE_LENGTH : 0);
+	uint8_t address = static_cast<uint8_t>(lcd->row_offset[y] & ~D6);
+	for (uint8_t i = 0; i < LCD_LINE_LENGTH; i++) {
+		lcd->shadow[line + address] = (*string != 0x0) ? *string++ : ' ';
+		if (++address == LCD_LINE_LENGTH)
+			address = 0;
+	}
+}
+
+/*
+	Sends the screen buffer to the display.
+	Only cells that differ from the content last sent are written. Changed cells that are close
+	together are sent as one run, the cursor is only moved if a run does not start where the
+	previous one ended. Everything is sent in one batch (see lcd_beginBatch()).
+	Characters outside of the visible window are sent as well (see lcd_bufferPutLine()).
+	The cursor direction is left to right afterwards.
+	
+	@param NONE
+	@return i2c_status SUCCESS if operation succeeded. Any other: See AVR128DB48_I2C Module.
+*/
+i2c_status lcd_flush() { // Removed void from parameter list for C++
+	
+	i2c_status result = lcd_flush_begin();
+	
+	bool done = false;
+	while (!done && result == SUCCESS)
+		result = lcd_flush_step(&done);
+	
+	return lcd_flush_end(result);
+}
+	
+/*
+	Sends the screen buffers of all initialized displays (see lcd_flush()).
+	The displays take turns: each one fills a stream buffer and hands it to the I2C queue,
+	then the next display fills one. While a buffer of one display is on the bus, the next
+	display is already prepared, so the bus schedule interleaves the transactions of all
+	displays instead of sending one display after the other. The selected display is kept.
+			
+	@param NONE
+	@return i2c_status SUCCESS if all displays succeeded, otherwise the first error.
+*/
+i2c_status lcd_flushAll() { // Removed void from parameter list for C++
+
+	lcd_display* selected = lcd;
+	i2c_status result[LCD_MAX_DISPLAYS];
+	bool done[LCD_MAX_DISPLAYS];
+
+	for (uint8_t i = 0; i < display_count; i++) {
+		lcd = displays[i];
+		result[i] = lcd_flush_begin();
+		done[i] = false;
+	}
+
+	// Round robin, one stream buffer per display and turn //
+	bool busy = true;
+	while (busy) {
+		busy = false;
+		for (uint8_t i = 0; i < display_count; i++) {
+			if (done[i] || result[i] != SUCCESS)
+				continue;
+			lcd = displays[i];
+			result[i] = lcd_flush_step(&done[i]);
+			busy = true;
+		}
+	}
+	
+	i2c_status first_error = SUCCESS;
+	for (uint8_t i = 0; i < display_count; i++) {
+		lcd = displays[i];
+		result[i] = lcd_flush_end(result[i]);
+		if (result[i] != SUCCESS && first_error == SUCCESS)
+			first_error = result[i];
+	}
+	
+	lcd = selected;
+	return first_error;
+}
+
+/*
+	Returns the character code of a custom character, e.g. for lcd_bufferPutChar().
+	Glyphs are identified by the address of their bitmap. A glyph that is already resident in CGRAM
+	only becomes the most recently used one; otherwise it takes a free slot or the least recently used
+	slot that is not on the screen buffer, and is uploaded by the next lcd_flush() (10 bytes).
+	If all 8 slots are in use by the screen buffer, the least recently used glyph is evicted anyway and
+	the cells showing it are replaced with a space: a single screen can show at most 8 custom characters.
+	Each display has its own CGRAM, the glyph is registered on the selected display.
+	
+	@param bitmap 8 rows of 5 pixels (bits 4 - 0), top row first. Must stay valid while the glyph is used.
+	@return char Character code (LCD_GLYPH_FIRST to LCD_GLYPH_FIRST + 7).
+*/
+char lcd_useGlyph(const uint8_t* bitmap) {
+	
+	// Already resident //
+	for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++) {
+		if (lcd->glyph_bitmap[slot] == bitmap) {
+			lcd_glyph_touch(slot);
+			return static_cast<char>(LCD_GLYPH_FIRST + slot);
+		}
+	}
+	
+	uint8_t slot = lcd_glyph_evict();
+	lcd->glyph_bitmap[slot] = bitmap;
+	lcd->glyph_pending |= static_cast<uint8_t>(1 << slot);
+	lcd_glyph_touch(slot);
+	
+	return static_cast<char>(LCD_GLYPH_FIRST + slot);
+}
+
+/*
+	Writes a custom character to the screen buffer (see lcd_useGlyph()).
+	
+	@param x Column (0 to columns - 1).
+	@param y Row (0 to rows - 1).
+	@param bitmap 8 rows of 5 pixels (bits 4 - 0), top row first.
+	@return NONE
+*/
+void lcd_bufferPutGlyph(uint8_t x, uint8_t y, const uint8_t* bitmap) {
+	lcd_bufferPutChar(x, y, lcd_useGlyph(bitmap));
+}
+
+/*
+	Draws a horizontal bar graph into the screen buffer with a resolution of 5 steps per cell.
+	Full cells use the block of the character ROM, so a bar needs at most one CGRAM slot
+	and, once the partial blocks are resident, a new value only costs the changed cells.
+	
+	@param x Column of the left end.
+	@param y Row.
+	@param width Length of the bar in cells.
+	@param value Value to show (values above full_scale show a full bar).
+	@param full_scale Value of a full bar.
+	@return NONE
+*/
+void lcd_bufferPutBar(uint8_t x, uint8_t y, uint8_t width, uint16_t value, uint16_t full_scale) {
+	if (full_scale == 0)
+		return;
+	if (value > full_scale)
+		value = full_scale;
+	
+	uint16_t columns = static_cast<uint16_t>((static_cast<uint32_t>(value) * width * 5) / full_scale);
+	for (uint8_t i = 0; i < width; i++, x++) {
+		if (columns >= 5) {
+			lcd_bufferPutChar(x, y, static_cast<char>(LCD_BAR_FULL));
+			columns = static_cast<uint16_t>(columns - 5);
+		}
+		else if (columns > 0) {
+			lcd_bufferPutGlyph(x, y, bar_glyph[columns - 1]);
+			columns = 0;
+		}
+		else {
+			lcd_bufferPutChar(x, y, ' ');
+		}
+	}
+}
+
+/*
+	Scrolls the display: the visible window moves over the 40 character lines, which wrap around.
+	Each step is one display shift instruction (4 expander states on the bus), independent of the
+	number of columns, and neither the cursor nor the DDRAM content changes. All rows move together.
+	The screen buffer functions keep working on the visible window at the new position.
+	
+	@param steps Positive: content moves to the left (window moves right), negative: content moves to the right.
+	@return i2c_status SUCCESS if operation succeeded. Any other: See AVR128DB48_I2C Module.
+*/
+i2c_status lcd_scroll(int8_t steps) {
+	
+	i2c_status result = SUCCESS;
+	lcd_beginBatch();
+	
+	while (steps != 0 && result == SUCCESS) {
+		if (steps > 0) {
+			result = lcd_write_data(static_cast<uint8_t>(D4 + D3), false, false, false);		// Shift display left
+			if (++lcd->shift == LCD_LINE_LENGTH)
+				lcd->shift = 0;
+			steps--;
+		}
+		else {
+			result = lcd_write_data(static_cast<uint8_t>(D4 + D3 + D2), false, false, false);	// Shift display right
+			lcd->shift = static_cast<uint8_t>((lcd->shift == 0) ? LCD_LINE_LENGTH - 1 : lcd->shift - 1);
+			steps++;
+		}
+	}
+	
+	i2c_status end = lcd_endBatch();
+	return (result == SUCCESS) ? end : result;
+}
+
+/*
+	@param NONE
+	@return uint8_t DDRAM address shown in column 0 of the first row (0 - 39).
+*/
+uint8_t lcd_scrollPosition() { // Removed void from parameter list for C++
+	return lcd->shift;
+}
+
+/*
+	Sets the function that draws the screen buffer. It is called by lcd_service()
+	with all events posted since the last call; all displays are flushed afterwards.
+	
+	@param function Render function (0 disables rendering).
+	@return NONE
+*/
+void lcd_setRenderer(lcd_renderer function) {
+	renderer = function;
+}
+
+/*
+	Requests a redraw. Safe to call from an ISR: it only sets event bits
+	(a few cycles, independent of the display), the drawing is done by lcd_service().
+	Events posted several times before the next lcd_service() are merged.
+	
+	@param events Application defined bit mask describing what changed.
+	@return NONE
+*/
+void lcd_post(uint8_t events) {
+	uint8_t sreg = SREG;	// Bit mask is shared with the main loop
+	cli();
+	pending_events |= events;
+	SREG = sreg;
+}
+
+/*
+	Renders and flushes the posted events. Call from the main loop (never from an ISR):
+	this is where the I2C transfers happen, while interrupts stay enabled.
+	
+	@param NONE
+	@return bool true if something was rendered.
+*/
+bool lcd_service() { // Removed void from parameter list for C++
+	uint8_t sreg = SREG;
+	cli();
+	uint8_t events = pending_events;
+	pending_events = 0;
+	SREG = sreg;
+	
+	if (events == 0 || renderer == 0)
+		return false;
+	
+	renderer(events);
+	lcd_flushAll();
+	return true;
+}
+
 // PRIVATE FUNCTIONS //
+// Position of a visible cell in shadow[] / shown[] (line * 40 + DDRAM address) //
+static uint8_t lcd_cell(uint8_t x, uint8_t y) {
+	uint8_t line = static_cast<uint8_t>((lcd->row_offset[y] & D6) ? LCD_LINE_LENGTH : 0);
+	uint8_t address = static_cast<uint8_t>((lcd->row_offset[y] & ~D6) + x + lcd->shift);
+	while (address >= LCD_LINE_LENGTH)
+		address = static_cast<uint8_t>(address - LCD_LINE_LENGTH);
+	
+	return static_cast<uint8_t>(line + address);
+}
+
+static i2c_status lcd_move_address(uint8_t position) {
+	uint8_t address = (position >= LCD_LINE_LENGTH) ? static_cast<uint8_t>(D6 + position - LCD_LINE_LENGTH) : position;
+	
+	if (lcd_write_data(static_cast<uint8_t>(D7 + address), false, false, false) != SUCCESS)	// Move Cursor (DDRAM Address)
+		return ERROR;
+	lcd->cursor = static_cast<int8_t>(position);
+	
+	return SUCCESS;
+}
+
+static i2c_status lcd_wait_long_instruction() { // Removed void from parameter list for C++
+	
+	if (wait_mode == LCD_WAIT_FIXED) {
+		_delay_us(1600);
+		return SUCCESS;
+	}
+	
+	// Poll the busy flag //
+	uint8_t value = 0;
+	for (uint8_t polls = 0; polls < LCD_BUSY_MAX_POLLS; polls++) {
+		if (lcd_readStatus(&value) != SUCCESS)
+			return ERROR;
+		if (!static_cast<bool>(value & D7))
+			return SUCCESS;
+	}
+	
+	return ERROR_NOT_READY;
+}
+
+static i2c_status lcd_flush_begin() { // Removed void from parameter list for C++
+
+	i2c_status result = SUCCESS;
+	lcd_beginBatch();
+	lcd->flush_position = 0;
+	lcd->flush_end = 0;
+
+	// New glyphs first, the cells using them are written below //
+	if (lcd->glyph_pending != 0)
+		result = lcd_glyph_upload();
+
+	if (lcd->cursor_step != 1 && result == SUCCESS)
+		result = lcd_leftToRight();
+
+	return result;
+}
+
+// Compares the screen buffer with the display until one stream buffer has been handed to the bus //
+static i2c_status lcd_flush_step(bool* done) {
+
+	i2c_status result = SUCCESS;
+	uint8_t submitted = lcd->submitted;
+
+	while (result == SUCCESS && lcd->submitted == submitted) {
+		uint8_t position = lcd->flush_position;
+
+		if (position >= LCD_DDRAM_SIZE) {
+			*done = true;
+			return SUCCESS;
+		}
+
+		if (position >= lcd->flush_end) {
+
+			// Skip unchanged cells //
+			if (lcd->shown_valid && lcd->shadow[position] == lcd->shown[position]) {
+				lcd->flush_position++;
+				continue;
+			}
+
+			// Find the end of the run //
+			uint8_t last = position;
+			for (uint8_t i = static_cast<uint8_t>(position + 1); i < LCD_DDRAM_SIZE && i <= last + LCD_FLUSH_MAX_GAP + 1; i++) {
+				if (!lcd->shown_valid || lcd->shadow[i] != lcd->shown[i])
+					last = i;
+			}
+			lcd->flush_end = static_cast<uint8_t>(last + 1);
+		}
+
+		// Move there, unless the previous character ended here //
+		if (lcd->cursor != position) {
+			result = lcd_move_address(position);
+			continue;
+		}
+
+		// Send the next character of the run //
+		result = lcd_putChar(lcd->shadow[position]);
+		lcd->flush_position++;
+	}
+
+	*done = false;
+	return result;
+}
+
+static i2c_status lcd_flush_end(i2c_status result) {
+
+	i2c_status end = lcd_endBatch();
+	if (result == SUCCESS)
+		result = end;
+
+	if (result != SUCCESS) {
+		lcd->shown_valid = false;		// Unknown what reached the display, rewrite everything next time
+		for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++) {
+			if (lcd->glyph_bitmap[slot] != 0)
+				lcd->glyph_pending |= static_cast<uint8_t>(1 << slot);
+		}
+		return result;
+	}
+	lcd->shown_valid = true;
+
+	return SUCCESS;
+}
+
+static void lcd_glyph_touch(uint8_t slot) {
+	
+	// Move slot to the front of the usage order //
+	uint8_t i = 0;
+	while (lcd->glyph_order[i] != slot)
+		i++;
+	for (; i > 0; i--)
+		lcd->glyph_order[i] = lcd->glyph_order[i - 1];
+	lcd->glyph_order[0] = slot;
+}
+
+static uint8_t lcd_glyph_evict() { // Removed void from parameter list for C++
+	
+	// Slots referenced by the screen buffer (bit mask) //
+	uint8_t referenced = 0;
+	for (uint8_t i = 0; i < LCD_DDRAM_SIZE; i++) {
+		uint8_t code = static_cast<uint8_t>(lcd->shadow[i]);
+		if (code >= LCD_GLYPH_FIRST && code < LCD_GLYPH_FIRST + LCD_GLYPH_SLOTS)
+			referenced |= static_cast<uint8_t>(1 << (code - LCD_GLYPH_FIRST));
+	}
+	
+	// Free slot or least recently used slot that is not on the screen //
+	uint8_t slot = lcd->glyph_order[LCD_GLYPH_SLOTS - 1];
+	for (int8_t i = LCD_GLYPH_SLOTS - 1; i >= 0; i--) {
+		uint8_t candidate = lcd->glyph_order[i];
+		if (lcd->glyph_bitmap[candidate] == 0) {
+			return candidate;
+		}
+		if (!static_cast<bool>(referenced & (1 << candidate)) && static_cast<bool>(referenced & (1 << slot)))
+			slot = candidate;
+	}
+	
+	// Cells still referencing the evicted glyph would show the new one //
+	if (static_cast<bool>(referenced & (1 << slot))) {
+		char code = static_cast<char>(LCD_GLYPH_FIRST + slot);
+		for (uint8_t i = 0; i < LCD_DDRAM_SIZE; i++)
+			if (lcd->shadow[i] == code)
+				lcd->shadow[i] = LCD_GLYPH_FALLBACK;
+	}
+	
+	return slot;
+}
+
+static i2c_status lcd_glyph_upload() { // Removed void from parameter list for C++
+	
+	for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++) {
+		if (!static_cast<bool>(lcd->glyph_pending & (1 << slot)))
+			continue;
+		
+		// Set CGRAM address, the address counter increments after each row //
+		if (lcd_write_data(static_cast<uint8_t>(D6 + (slot << 3)), false, false, false) != SUCCESS)
+			return ERROR;
+		for (uint8_t row = 0; row < 8; row++) {
+			if (lcd_write_data(lcd->glyph_bitmap[slot][row], true, false, false) != SUCCESS)
+				return ERROR;
+		}
+		lcd->glyph_pending &= static_cast<uint8_t>(~(1 << slot));
+	}
+	
+	// Address counter points into CGRAM, next character write needs a DDRAM address //
+	lcd->cursor = CURSOR_UNKNOWN;
+	return SUCCESS;
+}
+
+static void lcd_track_char(char character) {
+	
+	// Write at an unknown position -> display content is unknown //
+	if (lcd->cursor == CURSOR_UNKNOWN) {
+		lcd->shown_valid = false;
+		return;
+	}
+	
+	lcd->shown[lcd->cursor] = character;
+	
+	// The address counter runs from the end of one line to the start of the other //
+	lcd->cursor = static_cast<int8_t>(lcd->cursor + lcd->cursor_step);
+	if (lcd->cursor >= LCD_DDRAM_SIZE)
+		lcd->cursor = 0;
+	else if (lcd->cursor < 0)
+		lcd->cursor = LCD_DDRAM_SIZE - 1;
+}
+
+// Hands the filled stream buffer to the bus queue and continues in the other one //
+static i2c_status lcd_stream_flush() { // Removed void from parameter list for C++
+	if (lcd->stream_length == 0)
+		return SUCCESS;
+		
+	uint8_t index = lcd->stream_index;
+	i2c_transaction* transfer = &lcd->transfer[index];
+	transfer->address = lcd->address;
+	transfer->tx_data = lcd->stream[index];
+	transfer->tx_length = lcd->stream_length;
+	transfer->rx_data = 0;
+	transfer->rx_length = 0;
+	transfer->callback = 0;
+	transfer->context = 0;
+	i2c_enqueue(transfer);
+
+	lcd->in_flight |= static_cast<uint8_t>(1 << index);
+	lcd->submitted++;
+	lcd->stream_length = 0;
+	lcd->stream_index = static_cast<uint8_t>(index ^ 1);
+
+	// The other buffer may still be on the bus //
+	return lcd_stream_wait(lcd->stream_index);
+}
+
+static i2c_status lcd_stream_wait(uint8_t index) {
+	if (!static_cast<bool>(lcd->in_flight & (1 << index)))
+		return SUCCESS;
+
+	lcd->in_flight &= static_cast<uint8_t>(~(1 << index));
+	return i2c_wait(&lcd->transfer[index]);
+}
+
+// Sends everything and waits until it is on the display //
+static i2c_status lcd_stream_sync() { // Removed void from parameter list for C++
+	i2c_status result = lcd_stream_flush();
+
+	i2c_status other = lcd_stream_wait(0);
+	if (result == SUCCESS)
+		result = other;
+	other = lcd_stream_wait(1);
+	if (result == SUCCESS)
+		result = other;
+
+	return result;
+}
+
 static i2c_status lcd_write_data(uint8_t data, bool rs, bool rw, bool init) {
 	
 	// Split Data in Low and High half //
@@ -292,22 +1103,33 @@ static i2c_status lcd_write_data(uint8_t data, bool rs, bool rw, bool init) {
 		control += RS;
 	if (rw)
 		control += RW;
+	control = static_cast<uint8_t>(control + lcd->display_state);
+	
+	// Make room in the stream //
+	uint8_t needed = init ? 2 : static_cast<uint8_t>(4 + settle_states);
+	if (lcd->stream_length + needed > LCD_STREAM_SIZE) {
+		if (lcd_stream_flush() != SUCCESS)
+			return ERROR;
+	}
+	uint8_t* stream = lcd->stream[lcd->stream_index];
 		
-	// Send Bits 7 - 4 //
-	if (i2c_write_byte(DISPLAY_ADDRESS, static_cast<uint8_t>(high_data + control + display_state + E)) != SUCCESS)
-		return ERROR;
-	_delay_us(30);
-	if (i2c_write_byte(DISPLAY_ADDRESS, static_cast<uint8_t>(high_data + control + display_state)) != SUCCESS)		// Pull enable low
-		return ERROR;
-	_delay_us(37);
+	// Bits 7 - 4 //
+	stream[lcd->stream_length++] = static_cast<uint8_t>(high_data + control + E);
+	stream[lcd->stream_length++] = static_cast<uint8_t>(high_data + control);		// Pull enable low
 		
-	// Send Bits 3 - 0 (Only if not in initialization sequence) //
+	// Bits 3 - 0 (Only if not in initialization sequence) //
 	if (!init) {
-		if (i2c_write_byte(DISPLAY_ADDRESS, static_cast<uint8_t>(low_data + control + display_state + E)) != SUCCESS)
-			return ERROR;
-		_delay_us(30);
-		if (i2c_write_byte(DISPLAY_ADDRESS, static_cast<uint8_t>(low_data + control + display_state)) != SUCCESS)		// Pull enable low
-			return ERROR;
+		stream[lcd->stream_length++] = static_cast<uint8_t>(low_data + control + E);
+		stream[lcd->stream_length++] = static_cast<uint8_t>(low_data + control);		// Pull enable low
+		
+		// Keep E low until the instruction has been executed //
+		for (uint8_t i = 0; i < settle_states; i++)
+			stream[lcd->stream_length++] = static_cast<uint8_t>(low_data + control);
 	}
+	
+	// Send now, unless a batch is collected //
+	if (lcd->batch_depth == 0)
+		return lcd_stream_sync();
+		
 	return SUCCESS;
 }
@@ -23,6 +23,24 @@
  SCL - PA3
  
  Call lcd_init() before using any other function.
+ 
+ Several displays (different PCF8574 addresses, 16x2 / 20x4 / 40x2) can share the bus:
+ lcd_setup() a lcd_display for each, lcd_select() it and call lcd_init(). Drawing functions
+ work on the selected display; lcd_flushAll() sends the changes of all displays with their
+ I2C transactions interleaved in the bus queue.
+ 
+ For changing content, write into the screen buffer (lcd_bufferClear(), lcd_bufferPutString(), ...)
+ and call lcd_flush(): only the characters that changed are sent to the display.
+ 
+ Custom characters: lcd_useGlyph() returns the character code of a 5x8 bitmap; the driver keeps
+ up to 8 glyphs in CGRAM (least recently used is replaced) and uploads a glyph only if it is not resident.
+ 
+ Scrolling / marquee: lcd_bufferPutLine() fills the whole 40 character line of a row, including the part
+ outside of the display. After lcd_flush(), each lcd_scroll() step costs one instruction instead of
+ rewriting the row. The controller shifts all rows together.
+ 
+ Do not draw from an ISR. Post an event with lcd_post() instead and call lcd_service()
+ in the main loop; it calls the function set with lcd_setRenderer() and flushes all displays.
  */
 
 
@@ -32,14 +50,101 @@
 #include "../AVR128DB48_I2C/AVR128DB48_I2C.h"
 #include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
 
+#define LCD_COLUMNS	16	// Visible characters per row of the default display
+#define LCD_ROWS	2	// Visible rows of the default display
+#define LCD_LINE_LENGTH	40	// Characters per line of the display data RAM, visible or not
+#define LCD_DDRAM_SIZE	80	// Display data RAM: 2 lines of 40 characters (all geometries)
+#define LCD_MAX_DISPLAYS	8	// Displays on one bus (PCF8574 addresses 0x20 - 0x27)
+#define LCD_GLYPH_SLOTS	8	// Custom characters in CGRAM
+#define LCD_GLYPH_FIRST	8	// Character code of the first slot (codes 0 - 7 address the same slots, but 0 ends a string)
+#define LCD_STREAM_SIZE	64	// Expander states per I2C transaction (16 characters)
+
+typedef enum {
+	LCD_16X2,	// 16 characters, 2 rows
+	LCD_20X4,	// 20 characters, 4 rows
+	LCD_40X2	// 40 characters, 2 rows
+} lcd_geometry;
+
+typedef enum {
+	LCD_WAIT_FIXED,		// Wait the worst-case execution time of the datasheet
+	LCD_WAIT_BUSY_FLAG	// Poll the busy flag of the HD44780
+} lcd_wait_mode;
+
+typedef void (*lcd_renderer)(uint8_t events);	// Draws the screen buffer for the given events
+
+/*
+	State of one display. Set it up with lcd_setup(), the members are private to the driver.
+	Screen buffers mirror the display data RAM (index = line * 40 + address), including the
+	characters outside of the visible window that hardware scrolling brings into view.
+*/
+typedef struct {
+	uint8_t			address;						// 7-Bit address of the PCF8574
+	uint8_t			columns;						// Geometry
+	uint8_t			rows;
+	const uint8_t*	row_offset;						// DDRAM address of the first character of each row
+	uint8_t			display_state;					// Backlight bit, or-ed into every expander state
+	char			shadow[LCD_DDRAM_SIZE];			// Content requested by the lcd_buffer*() functions
+	char			shown[LCD_DDRAM_SIZE];			// Content last sent to the display
+	bool			shown_valid;					// false: shown[] does not match the display
+	int8_t			cursor;							// Address counter as tracked by the driver (index into shown, -1: unknown)
+	int8_t			cursor_step;					// +1: left to right, -1: right to left
+	uint8_t			shift;							// Display shift: visible column 0 shows address 0 + shift
+	uint8_t			stream[2][LCD_STREAM_SIZE];		// Expander states, one buffer is filled while the other is on the bus
+	i2c_transaction	transfer[2];					// Bus transaction of each stream buffer
+	uint8_t			stream_index;					// Buffer being filled
+	uint8_t			stream_length;					// Number of states in that buffer
+	uint8_t			in_flight;						// Buffers (bit mask) handed to the bus and not yet waited for
+	uint8_t			submitted;						// Counts handed over buffers (lets lcd_flushAll() switch displays)
+	uint8_t			batch_depth;					// Nesting of lcd_beginBatch() calls
+	const uint8_t*	glyph_bitmap[LCD_GLYPH_SLOTS];	// Glyph held by each CGRAM slot (0: free)
+	uint8_t			glyph_order[LCD_GLYPH_SLOTS];	// Slots, most recently used first
+	uint8_t			glyph_pending;					// Slots (bit mask) whose bitmap still has to be uploaded
+	uint8_t			flush_position;					// Progress of lcd_flush()
+	uint8_t			flush_end;						// End of the run being sent
+} lcd_display;
+
+// Displays: all other functions work on the selected display (default: 16x2 at 0x27) //
+void lcd_setup(lcd_display* display, uint8_t address, lcd_geometry geometry);
+void lcd_select(lcd_display* display);
+lcd_display* lcd_selected(); // Removed void from parameter list for C++
+uint8_t lcd_columns(); // Removed void from parameter list for C++
+uint8_t lcd_rows(); // Removed void from parameter list for C++
+
 i2c_status lcd_init(); // Removed void from parameter list for C++
 i2c_status lcd_enable(bool enable);
 i2c_status lcd_clear(); // Removed void from parameter list for C++
 i2c_status lcd_moveCursor(uint8_t x, uint8_t y);
 i2c_status lcd_backlight(bool enable);
 i2c_status lcd_putChar(char character);
-i2c_status lcd_putString(char* string);
+i2c_status lcd_putString(const char* string);
 i2c_status lcd_leftToRight(); // Removed void from parameter list for C++
 i2c_status lcd_rightToLeft(); // Removed void from parameter list for C++
+void lcd_beginBatch(); // Removed void from parameter list for C++
+i2c_status lcd_endBatch(); // Removed void from parameter list for C++
+i2c_status lcd_command(uint8_t instruction);
+void lcd_setWaitMode(lcd_wait_mode mode);
+i2c_status lcd_readStatus(uint8_t* value);
+
+// Screen buffer: write into RAM, then send only the changed cells with lcd_flush() //
+void lcd_bufferClear(); // Removed void from parameter list for C++
+void lcd_bufferPutChar(uint8_t x, uint8_t y, char character);
+void lcd_bufferPutString(uint8_t x, uint8_t y, const char* string);
+void lcd_bufferPutLine(uint8_t y, const char* string);
+i2c_status lcd_flush(); // Removed void from parameter list for C++
+i2c_status lcd_flushAll(); // Removed void from parameter list for C++
+
+// Custom characters (5x8 bitmaps, one byte per row, bits 4 - 0) //
+char lcd_useGlyph(const uint8_t* bitmap);
+void lcd_bufferPutGlyph(uint8_t x, uint8_t y, const uint8_t* bitmap);
+void lcd_bufferPutBar(uint8_t x, uint8_t y, uint8_t width, uint16_t value, uint16_t full_scale);
+
+// Hardware scrolling: shifts the visible window over the 40 character lines, one instruction per step //
+i2c_status lcd_scroll(int8_t steps);
+uint8_t lcd_scrollPosition(); // Removed void from parameter list for C++
+
+// Render task: ISRs post events, the main loop renders them //
+void lcd_setRenderer(lcd_renderer function);
+void lcd_post(uint8_t events);
+bool lcd_service(); // Removed void from parameter list for C++
 
 #endif /* I2C_LCD_H_ */
\ No newline at end of file
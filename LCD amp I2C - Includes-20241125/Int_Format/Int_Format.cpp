@@ -0,0 +1,219 @@
+/*
+ ***********************************************************************************
+ * @file:   Int_Format.cpp
+ * @date:   16.10.2026
+ *
+ * This module converts integers to text without division (see Int_Format.h).
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+ */
+
+// INCLUDES //
+#include "Int_Format.h"
+
+// VARIABLES //
+static const uint32_t powers_of_ten[] = {1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL};
+static const char hex_digits[] = "0123456789ABCDEF";
+
+// PRIVATE FUNCTION DECLARATIONS //
+static uint32_t magnitude(int32_t value);
+
+// PUBLIC FUNCTIONS //
+/*
+*	Decimal representation without leading zeros.
+*
+*	@param buf At least 11 characters
+*	@param value Number to convert
+*	@return uint8_t Number of characters (without '\0')
+*/
+uint8_t int_format_unsigned(char* buf, uint32_t value) {
+	char* out = buf;
+	uint8_t power = 0;
+
+	// Digits 10^9 - 10^4: at most 9 subtractions each //
+	while (power < sizeof(powers_of_ten) / sizeof(powers_of_ten[0]) && value < powers_of_ten[power])
+		power++;
+	for (; power < sizeof(powers_of_ten) / sizeof(powers_of_ten[0]); power++) {
+		char digit = '0';
+		while (value >= powers_of_ten[power]) {
+			value -= powers_of_ten[power];
+			digit++;
+		}
+		*out++ = digit;
+	}
+
+	// Digits 10^3 - 10^0: value < 10000, x / 10 == x * 0xCCCD >> 19 for all 16-bit x //
+	uint16_t low = static_cast<uint16_t>(value);
+	bool leading = (out != buf);	// Upper digits written: keep all four digits
+	char digits[4];
+	uint8_t count = 0;
+	do {
+		uint16_t quotient = static_cast<uint16_t>((static_cast<uint32_t>(low) * 0xCCCDUL) >> 19);
+		digits[count++] = static_cast<char>('0' + (low - quotient * 10));
+		low = quotient;
+	} while (low != 0 || (leading && count < 4));
+
+	while (count > 0)
+		*out++ = digits[--count];
+	*out = '\0';
+
+	return static_cast<uint8_t>(out - buf);
+}
+
+/*
+*	Decimal representation with '-' for negative numbers (INT32_MIN included).
+*
+*	@param buf At least 12 characters
+*	@param value Number to convert
+*	@return uint8_t Number of characters (without '\0')
+*/
+uint8_t int_format_signed(char* buf, int32_t value) {
+	if (value >= 0)
+		return int_format_unsigned(buf, static_cast<uint32_t>(value));
+
+	*buf = '-';
+	return static_cast<uint8_t>(int_format_unsigned(buf + 1, magnitude(value)) + 1);
+}
+
+/*
+*	Hexadecimal representation (upper case digits).
+*
+*	@param buf At least digits + 1 characters (9 for digits = 0)
+*	@param value Number to convert
+*	@param digits Number of digits with leading zeros (1 - 8), 0: as many as needed
+*	@return uint8_t Number of characters (without '\0')
+*/
+uint8_t int_format_hex(char* buf, uint32_t value, uint8_t digits) {
+	if (digits == 0) {
+		digits = 1;
+		for (uint32_t rest = value >> 4; rest != 0; rest >>= 4)
+			digits++;
+	}
+	if (digits > 8)
+		digits = 8;
+
+	buf[digits] = '\0';
+	for (uint8_t i = digits; i > 0; i--) {
+		buf[i - 1] = hex_digits[value & 0x0F];
+		value >>= 4;
+	}
+
+	return digits;
+}
+
+/*
+*	Binary representation.
+*
+*	@param buf At least digits + 1 characters (33 for digits = 0)
+*	@param value Number to convert
+*	@param digits Number of digits with leading zeros (1 - 32), 0: as many as needed
+*	@return uint8_t Number of characters (without '\0')
+*/
+uint8_t int_format_binary(char* buf, uint32_t value, uint8_t digits) {
+	if (digits == 0) {
+		digits = 1;
+		for (uint32_t rest = value >> 1; rest != 0; rest >>= 1)
+			digits++;
+	}
+	if (digits > 32)
+		digits = 32;
+
+	buf[digits] = '\0';
+	for (uint8_t i = digits; i > 0; i--) {
+		buf[i - 1] = static_cast<char>('0' + (value & 0x01));
+		value >>= 1;
+	}
+
+	return digits;
+}
+
+/*
+*	Decimal representation right aligned in a field of fixed width,
+*	e.g. to overwrite a column of the LCD without clearing it first.
+*	If the number does not fit, the field is filled with INT_FORMAT_OVERFLOW.
+*
+*	@param buf At least width + 1 characters
+*	@param value Number to convert
+*	@param width Width of the field
+*	@param fill Character left of the number (' ' or '0')
+*	@return uint8_t width
+*/
+uint8_t int_format_right(char* buf, int32_t value, uint8_t width, char fill) {
+	char number[12];
+	uint8_t length = int_format_signed(number, value);
+
+	if (length > width) {
+		for (uint8_t i = 0; i < width; i++)
+			buf[i] = INT_FORMAT_OVERFLOW;
+		buf[width] = '\0';
+		return width;
+	}
+
+	uint8_t start = static_cast<uint8_t>(width - length);
+	for (uint8_t i = 0; i < start; i++)
+		buf[i] = fill;
+
+	// Zero padding goes between sign and digits //
+	if (fill == '0' && number[0] == '-' && start > 0) {
+		buf[0] = '-';
+		number[0] = '0';
+	}
+	for (uint8_t i = 0; i <= length; i++)
+		buf[start + i] = number[i];
+
+	return width;
+}
+
+/*
+*	Interface of the former integer_to_string() copies of the examples.
+*	Base 10, 2 and 16 use the division-free functions above (negative numbers as '-' and
+*	magnitude, hexadecimal digits in upper case), other bases fall back to division.
+*
+*	@param buf At least INT_FORMAT_SIZE characters
+*	@param num Number to convert
+*	@param base Base of the representation (2 - 16, others are treated as 10)
+*	@return char* buf
+*/
+char* integer_to_string(char* buf, int32_t num, int base) {
+	char* digits = buf;
+	uint32_t value = magnitude(num);
+
+	if (base < 2 || base > 16)
+		base = 10;
+	if (base == 10) {
+		int_format_signed(buf, num);
+		return buf;
+	}
+
+	if (num < 0)
+		*digits++ = '-';
+
+	switch (base) {
+		case 2:		int_format_binary(digits, value, 0);	break;
+		case 16:	int_format_hex(digits, value, 0);		break;
+		default: {
+			uint8_t count = 0;
+			char reversed[INT_FORMAT_SIZE];
+			do {
+				reversed[count++] = hex_digits[value % static_cast<uint8_t>(base)];
+				value /= static_cast<uint8_t>(base);
+			} while (value != 0);
+			while (count > 0)
+				*digits++ = reversed[--count];
+			*digits = '\0';
+			break;
+		}
+	}
+
+	return buf;
+}
+
+// PRIVATE FUNCTIONS //
+static uint32_t magnitude(int32_t value) {
+	return (value < 0) ? 0UL - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+}
@@ -0,0 +1,54 @@
+/*
+ ***********************************************************************************
+ * @file:   Int_Format.h
+ * @date:   16.10.2026
+ *
+ * This module converts integers to text without division (the AVR has no divider,
+ * every / or % by a runtime base is a library call of several hundred cycles).
+ * - Decimal: the digits above 10^4 are found by subtracting powers of ten, the lower
+ *   four digits by multiplying with the reciprocal of 10 (x * 0xCCCD >> 19).
+ * - Hexadecimal / binary: shifts and masks only.
+ * - Fixed width: right aligned with a fill character, for columns on the LCD.
+ *
+ * integer_to_string() keeps the interface of the former copies in the examples.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Usage:
+  char buf[INT_FORMAT_SIZE];
+  int_format_signed(buf, -1234);              -> "-1234"
+  int_format_right(buf, 42, 5, ' ');          -> "   42"
+  int_format_hex(buf, 0xBEEF, 8);             -> "0000BEEF"
+  See Int_Format_Host.cpp for the check against the former routine and the benchmark.
+*/
+
+
+#ifndef INT_FORMAT_H_
+#define INT_FORMAT_H_
+
+// INCLUDES //
+#include <stdint.h>
+
+// DEFINES //
+#define INT_FORMAT_SIZE		34		// Largest result: 32 binary digits + '-' + '\0'
+#define INT_FORMAT_OVERFLOW	'#'		// Fills a fixed width field if the number does not fit
+
+// FUNCTION DECLARATIONS //
+uint8_t int_format_unsigned(char* buf, uint32_t value);
+
+uint8_t int_format_signed(char* buf, int32_t value);
+
+uint8_t int_format_hex(char* buf, uint32_t value, uint8_t digits);
+
+uint8_t int_format_binary(char* buf, uint32_t value, uint8_t digits);
+
+uint8_t int_format_right(char* buf, int32_t value, uint8_t width, char fill);
+
+char* integer_to_string(char* buf, int32_t num, int base);
+
+#endif /* INT_FORMAT_H_ */
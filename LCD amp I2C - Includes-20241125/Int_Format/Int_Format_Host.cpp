@@ -0,0 +1,182 @@
+/*
+ ***********************************************************************************
+ * @file:   Int_Format_Host.cpp
+ * @date:   16.10.2026
+ *
+ * Workstation check and benchmark of the Int_Format module:
+ * - every function is compared with snprintf() for edge values and pseudo-random values,
+ * - integer_to_string() is compared with the former copy of the examples,
+ * - both decimal routines are timed.
+ * The workstation CPU divides in hardware (the former routine is even faster there), so the
+ * timing says little about the AVR: the cycles on the target are measured by
+ * int_format_benchmark() (AVR_LCD_Display_Projects/main7.cpp).
+ *
+ * Build and run (in this directory):
+ *   g++ -std=gnu++14 -O2 Int_Format_Host.cpp Int_Format.cpp -o int_format && ./int_format
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+*/
+
+// INCLUDES //
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "Int_Format.h"
+
+// DEFINES //
+#define RANDOM_VALUES	1000000UL
+#define BENCHMARK_RUNS	10000000UL
+
+// VARIABLES //
+static uint32_t failures = 0;
+static uint32_t random_state = 0x12345678UL;
+
+static const int32_t edge_values[] = {
+	0, 1, -1, 9, 10, 99, 100, 999, 1000, 9999, 10000, 10001, 65535, 65536, 99999, 100000,
+	999999999, 1000000000, 2147483647, -2147483647, -2147483647 - 1, -10000, -9999
+};
+
+// PRIVATE FUNCTIONS //
+// Copy of the routine formerly pasted into the examples (reference) //
+static char* legacy_integer_to_string(char *buf, int32_t num, int base) {
+	bool isNegative = false;
+	int digitCounter = 0;
+
+	if (num == 0) {
+		buf[digitCounter++] = '0';
+	}
+
+	if (num < 0) {
+		isNegative = true;
+		num = static_cast<int32_t>(~num + 1);
+	}
+
+	while (num > 0) {
+		buf[digitCounter++] = static_cast<char>('0' + num % base);
+		num /= base;
+	}
+
+	if (isNegative) {
+		buf[digitCounter++] = '-';
+	}
+
+	buf[digitCounter] = '\0';
+
+	for (int i = 0, j = digitCounter - 1; i < j; i++, j--) {
+		char temp = buf[i];
+		buf[i] = buf[j];
+		buf[j] = temp;
+	}
+
+	return buf;
+}
+
+static uint32_t next_random() {
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+static void expect(const char* function, int32_t value, const char* result, const char* expected) {
+	if (strcmp(result, expected) == 0)
+		return;
+	if (failures++ < 10)
+		printf("  %s(%ld): \"%s\", expected \"%s\"\n", function, static_cast<long>(value), result, expected);
+}
+
+static void check_value(int32_t value) {
+	char result[INT_FORMAT_SIZE];
+	char expected[INT_FORMAT_SIZE];
+	uint32_t bits = static_cast<uint32_t>(value);
+
+	int_format_signed(result, value);
+	snprintf(expected, sizeof(expected), "%ld", static_cast<long>(value));
+	expect("int_format_signed", value, result, expected);
+
+	int_format_unsigned(result, bits);
+	snprintf(expected, sizeof(expected), "%lu", static_cast<unsigned long>(bits));
+	expect("int_format_unsigned", value, result, expected);
+
+	int_format_hex(result, bits, 0);
+	snprintf(expected, sizeof(expected), "%lX", static_cast<unsigned long>(bits));
+	expect("int_format_hex", value, result, expected);
+
+	int_format_hex(result, bits, 8);
+	snprintf(expected, sizeof(expected), "%08lX", static_cast<unsigned long>(bits));
+	expect("int_format_hex(8)", value, result, expected);
+
+	int_format_binary(result, bits, 0);
+	uint8_t length = 0;
+	char reversed[33];
+	do {
+		reversed[length++] = static_cast<char>('0' + (bits & 1));
+		bits >>= 1;
+	} while (bits != 0);
+	for (uint8_t i = 0; i < length; i++)
+		expected[i] = reversed[length - 1 - i];
+	expected[length] = '\0';
+	expect("int_format_binary", value, result, expected);
+
+	int_format_right(result, value, 11, ' ');
+	snprintf(expected, sizeof(expected), "%11ld", static_cast<long>(value));
+	expect("int_format_right", value, result, expected);
+
+	int_format_right(result, value, 11, '0');
+	snprintf(expected, sizeof(expected), "%011ld", static_cast<long>(value));
+	expect("int_format_right('0')", value, result, expected);
+
+	// The former routine overflows for INT32_MIN //
+	if (value != -2147483647 - 1) {
+		integer_to_string(result, value, 10);
+		legacy_integer_to_string(expected, value, 10);
+		expect("integer_to_string(10)", value, result, expected);
+
+		integer_to_string(result, value, 2);
+		legacy_integer_to_string(expected, value, 2);
+		expect("integer_to_string(2)", value, result, expected);
+	}
+}
+
+static double benchmark(char* (*function)(char*, int32_t, int)) {
+	char buf[INT_FORMAT_SIZE];
+	uint32_t checksum = 0;
+	random_state = 0x12345678UL;
+
+	clock_t start = clock();
+	for (uint32_t i = 0; i < BENCHMARK_RUNS; i++) {
+		function(buf, static_cast<int32_t>(next_random() >> (i & 31)), 10);
+		checksum += static_cast<uint8_t>(buf[0]);
+	}
+	clock_t end = clock();
+
+	if (checksum == 0)
+		printf("  (checksum %lu)\n", static_cast<unsigned long>(checksum));
+	return static_cast<double>(end - start) * 1e9 / CLOCKS_PER_SEC / BENCHMARK_RUNS;
+}
+
+// PUBLIC FUNCTIONS //
+int main() { // Changed from main(void) to int main()
+
+	char buf[INT_FORMAT_SIZE];
+
+	printf("Check against snprintf() and the former integer_to_string()\n");
+	for (uint8_t i = 0; i < sizeof(edge_values) / sizeof(edge_values[0]); i++)
+		check_value(edge_values[i]);
+	for (uint32_t i = 0; i < RANDOM_VALUES; i++)
+		check_value(static_cast<int32_t>(next_random() >> (i & 31)));	// All magnitudes
+	int_format_right(buf, 123456, 4, ' ');
+	expect("int_format_right(overflow)", 123456, buf, "####");
+	printf("  %s (%lu failures)\n\n", failures == 0 ? "OK" : "FAILED", static_cast<unsigned long>(failures));
+
+	printf("Decimal conversion, ns per call (values of all magnitudes)\n");
+	printf("  former integer_to_string(): %6.1f\n", benchmark(legacy_integer_to_string));
+	printf("  Int_Format:                 %6.1f\n", benchmark(integer_to_string));
+
+	return (failures == 0) ? 0 : 1;
+}
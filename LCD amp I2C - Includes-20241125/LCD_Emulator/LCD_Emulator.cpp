@@ -0,0 +1,481 @@
+/*
+ ***********************************************************************************
+ * @file:   LCD_Emulator.cpp
+ * @date:   16.10.2026
+ *
+ * Workstation model of the HW-061 module (PCF8574 + HD44780), see LCD_Emulator.h.
+ *
+ * HD44780 Datasheet:
+ * https://www.sparkfun.com/datasheets/LCD/HD44780.pdf
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+*/
+
+// INCLUDES //
+#include <avr/io.h>
+#include "LCD_Emulator.h"
+
+// DEFINES //
+#define RS	0b00000001		// Expander pins as wired on the HW-061 (see I2C_LCD.cpp)
+#define RW	0b00000010
+#define E	0b00000100
+
+#define DDRAM_SIZE			80		// 2 lines of 40 characters
+#define LINE_LENGTH			40
+#define CGRAM_SIZE			64		// 8 characters of 8 rows
+#define EXECUTION_TIME_NS	37000UL		// All instructions except clear / return home (270kHz)
+#define LONG_EXECUTION_NS	1520000UL	// Clear display / return home
+
+// TYPES //
+typedef struct {
+	bool		attached;
+	uint8_t		address;
+	uint8_t		columns;
+	uint8_t		rows;
+	uint8_t		port;				// Last state written to the expander
+	bool		four_bit;			// Interface length (false after power-on)
+	bool		nibble_pending;		// High nibble received, waiting for the low one
+	uint8_t		high_nibble;
+	bool		read_low;			// Next read cycle returns the low nibble
+	uint8_t		read_nibble;		// Nibble the controller drives on D7 - D4 while E is high
+	char		ddram[DDRAM_SIZE];	// Index = line * 40 + address
+	uint8_t		cgram[CGRAM_SIZE];
+	uint8_t		ac;					// Address counter (DDRAM index or CGRAM address)
+	bool		cgram_mode;			// Address counter points into CGRAM
+	bool		increment;			// Entry mode I/D
+	bool		entry_shift;		// Entry mode S
+	bool		display_on;
+	uint8_t		shift;				// Visible column 0 shows address 0 + shift
+	uint64_t	busy_until_ns;
+} emulator_panel;
+
+// VARIABLES //
+PORT_t PORTA, PORTB, PORTC, PORTD, PORTE, PORTF;	// Registers of the host stand-in <avr/io.h>
+TCA_t TCA0, TCA1;
+TCB_t TCB0, TCB1, TCB2, TCB3;
+CPU_t CPU;
+
+static emulator_panel panels[EMULATOR_PANELS];
+static uint32_t scl_frequency = 100000UL;
+static uint64_t now_ns = 0;						// Modelled time since emulator_reset()
+static emulator_stats stats;
+static uint64_t bus_time_ns = 0;				// Not yet reported in stats.bus_time_us
+static uint64_t delay_time_ns = 0;
+static emulator_delay_hook delay_hook = 0;
+static emulator_input_hook input_hook = 0;
+
+// PRIVATE FUNCTION DECLARATIONS //
+static emulator_panel* find_panel(uint8_t address);
+static void bus_bits(uint8_t bits);
+static i2c_status bus_transfer(uint8_t address, const uint8_t* tx_data, uint8_t tx_length, uint8_t* rx_data, uint8_t rx_length);
+static void panel_write(emulator_panel* panel, uint8_t value);
+static uint8_t panel_read(emulator_panel* panel);
+static void panel_latch(emulator_panel* panel, uint8_t nibble, bool rs);
+static void panel_execute(emulator_panel* panel, uint8_t data, bool rs);
+static uint8_t panel_step(uint8_t index, bool increment);
+
+// PUBLIC FUNCTIONS //
+/*
+*	Removes all panels, resets time and statistics and attaches a 16x2 panel at 0x27
+*	(the default display of I2C_LCD).
+*/
+void emulator_reset() { // Removed void from parameter list for C++
+	for (uint8_t i = 0; i < EMULATOR_PANELS; i++)
+		panels[i].attached = false;
+	now_ns = 0;
+	bus_time_ns = 0;
+	delay_time_ns = 0;
+	stats = emulator_stats();
+	SREG = 0;
+
+	emulator_attach(0x27, 16, 2);
+}
+
+/*
+*	Attaches a powered-on panel (controller in 8-bit mode, DDRAM filled with spaces).
+*
+*	@param address 7-Bit address of the PCF8574
+*	@param columns Characters per row (up to 40)
+*	@param rows Rows (1, 2 or 4)
+*	@return bool false if all panels are in use
+*/
+bool emulator_attach(uint8_t address, uint8_t columns, uint8_t rows) {
+	emulator_panel* panel = find_panel(address);
+	for (uint8_t i = 0; panel == 0 && i < EMULATOR_PANELS; i++) {
+		if (!panels[i].attached)
+			panel = &panels[i];
+	}
+	if (panel == 0)
+		return false;
+
+	*panel = emulator_panel();
+	panel->attached = true;
+	panel->address = address;
+	panel->columns = columns;
+	panel->rows = rows;
+	panel->increment = true;
+	for (uint8_t i = 0; i < DDRAM_SIZE; i++)
+		panel->ddram[i] = ' ';
+
+	return true;
+}
+
+/*
+*	Returns the bus cost since the previous call and starts counting again.
+*/
+emulator_stats emulator_takeStats() { // Removed void from parameter list for C++
+	emulator_stats result = stats;
+	result.bus_time_us = static_cast<uint32_t>(bus_time_ns / 1000);
+	result.delay_time_us = static_cast<uint32_t>(delay_time_ns / 1000);
+
+	stats = emulator_stats();
+	bus_time_ns = 0;
+	delay_time_ns = 0;
+	return result;
+}
+
+/*
+*	@return uint64_t Modelled time since emulator_reset() (bus transfers and delays)
+*/
+uint64_t emulator_time_us() { // Removed void from parameter list for C++
+	return now_ns / 1000;
+}
+
+/*
+*	Renders the visible text of a panel, one line per row ending with '\n'.
+*	CGRAM characters are shown as EMULATOR_GLYPH_CHAR, the full block as EMULATOR_BLOCK_CHAR,
+*	other codes outside of printable ASCII as '?'. A switched off display is blank.
+*
+*	@param address Address of the panel
+*	@param screen At least EMULATOR_SCREEN_SIZE characters
+*	@return bool false if no panel is attached at the address
+*/
+bool emulator_render(uint8_t address, char* screen) {
+	emulator_panel* panel = find_panel(address);
+	if (panel == 0)
+		return false;
+
+	for (uint8_t y = 0; y < panel->rows; y++) {
+		uint8_t line = static_cast<uint8_t>((y & 1) * LINE_LENGTH);
+		uint8_t base = (y >= 2) ? panel->columns : 0;	// Rows 2 / 3 continue rows 0 / 1
+
+		for (uint8_t x = 0; x < panel->columns; x++) {
+			uint8_t code = static_cast<uint8_t>(panel->ddram[line + (base + x + panel->shift) % LINE_LENGTH]);
+			char character;
+			if (!panel->display_on)
+				character = ' ';
+			else if (code < 16)
+				character = EMULATOR_GLYPH_CHAR;
+			else if (code == 0xFF)
+				character = EMULATOR_BLOCK_CHAR;
+			else if (code >= 0x20 && code < 0x7F)
+				character = static_cast<char>(code);
+			else
+				character = '?';
+			*screen++ = character;
+		}
+		*screen++ = '\n';
+	}
+	*screen = '\0';
+
+	return true;
+}
+
+/*
+*	Copies the bitmap of a CGRAM character.
+*
+*	@param address Address of the panel
+*	@param slot Character 0 - 7
+*	@param rows 8 rows of 5 pixels (bits 4 - 0)
+*	@return bool false if no panel is attached at the address
+*/
+bool emulator_glyph(uint8_t address, uint8_t slot, uint8_t* rows) {
+	emulator_panel* panel = find_panel(address);
+	if (panel == 0)
+		return false;
+
+	for (uint8_t row = 0; row < 8; row++)
+		rows[row] = panel->cgram[((slot & 0x07) << 3) + row];
+	return true;
+}
+
+/*
+*	@param hook Called after every delay with its duration (0: none)
+*/
+void emulator_setDelayHook(emulator_delay_hook hook) {
+	delay_hook = hook;
+}
+
+/*
+*	@param hook Called on every read of PORTx.IN (0: the register value is returned)
+*/
+void emulator_setInputHook(emulator_input_hook hook) {
+	input_hook = hook;
+}
+
+/*
+*	Implementation of _delay_us() / _delay_ms() of the host <util/delay.h>.
+*
+*	@param us Duration of the delay
+*/
+void emulator_delay_us(uint32_t us) {
+	now_ns += static_cast<uint64_t>(us) * 1000;
+	delay_time_ns += static_cast<uint64_t>(us) * 1000;
+
+	if (delay_hook != 0)
+		delay_hook(us);
+}
+
+/*
+*	Reading PORTx.IN (see host <avr/io.h>).
+*/
+host_port_input::operator uint8_t() const {
+	if (input_hook == 0)
+		return value;
+
+	PORT_t* ports[] = {&PORTA, &PORTB, &PORTC, &PORTD, &PORTE, &PORTF};
+	for (uint8_t port = 0; port < 6; port++) {
+		if (&ports[port]->IN == this)
+			return input_hook(port, value);
+	}
+	return value;
+}
+
+// I2C MODULE (replaces AVR128DB48_I2C.cpp) //
+/*
+*	Transfers complete immediately; the queue functions keep their contract
+*	(done / status / callback), so the LCD driver needs no host specific code.
+*	Unlike the target, every mode is accepted regardless of F_CPU.
+*/
+i2c_status i2c_init(i2c_mode mode) {
+	switch (mode) {
+		case FAST_MODE:			scl_frequency = 400000UL;	break;
+		case FAST_MODE_PLUS:	scl_frequency = 1000000UL;	break;
+		default:				scl_frequency = 100000UL;	break;
+	}
+	return SUCCESS;
+}
+
+bool i2c_submit(i2c_transaction* transaction) {
+	transaction->status = bus_transfer(transaction->address, transaction->tx_data, transaction->tx_length, transaction->rx_data, transaction->rx_length);
+	transaction->done = true;
+
+	if (transaction->callback != 0)
+		transaction->callback(transaction->status, transaction->context);
+	return true;
+}
+
+void i2c_enqueue(i2c_transaction* transaction) {
+	i2c_submit(transaction);
+}
+
+i2c_status i2c_wait(i2c_transaction* transaction) {
+	return transaction->status;
+}
+
+bool i2c_busy() { // Removed void from parameter list for C++
+	return false;
+}
+
+i2c_status i2c_write(uint8_t address, uint8_t* data, uint8_t length) {
+	return bus_transfer(address, data, length, 0, 0);
+}
+
+i2c_status i2c_write_byte(uint8_t address, uint8_t data) {
+	return bus_transfer(address, &data, 1, 0, 0);
+}
+
+i2c_status i2c_read(uint8_t address, uint8_t* data, uint8_t length) {
+	return bus_transfer(address, 0, 0, data, length);
+}
+
+i2c_status i2c_read_byte(uint8_t address, uint8_t* data) {
+	return bus_transfer(address, 0, 0, data, 1);
+}
+
+i2c_status i2c_write_read(uint8_t address, uint8_t* tx_data, uint8_t tx_length, uint8_t* rx_data, uint8_t rx_length) {
+	return bus_transfer(address, tx_data, tx_length, rx_data, rx_length);
+}
+
+// PRIVATE FUNCTIONS //
+static emulator_panel* find_panel(uint8_t address) {
+	for (uint8_t i = 0; i < EMULATOR_PANELS; i++) {
+		if (panels[i].attached && panels[i].address == address)
+			return &panels[i];
+	}
+	return 0;
+}
+
+// Advances the modelled time by a number of SCL periods //
+static void bus_bits(uint8_t bits) {
+	uint64_t duration = static_cast<uint64_t>(bits) * 1000000000ULL / scl_frequency;
+	now_ns += duration;
+	bus_time_ns += duration;
+}
+
+static i2c_status bus_transfer(uint8_t address, const uint8_t* tx_data, uint8_t tx_length, uint8_t* rx_data, uint8_t rx_length) {
+
+	emulator_panel* panel = find_panel(address);
+	stats.transactions++;
+	bus_bits(1);								// START
+
+	// Write phase: address + data, the expander outputs change after each byte //
+	if (tx_length > 0 || rx_length == 0) {
+		stats.bytes++;
+		bus_bits(9);
+		if (panel == 0) {
+			bus_bits(1);						// STOP
+			return NACK;
+		}
+		for (uint8_t i = 0; i < tx_length; i++) {
+			stats.bytes++;
+			bus_bits(9);
+			panel_write(panel, tx_data[i]);
+		}
+	}
+
+	// Read phase (after a repeated START if something was written) //
+	if (rx_length > 0) {
+		if (tx_length > 0)
+			bus_bits(1);						// Repeated START
+		stats.bytes++;
+		bus_bits(9);
+		if (panel == 0) {
+			bus_bits(1);
+			return NACK;
+		}
+		for (uint8_t i = 0; i < rx_length; i++) {
+			stats.bytes++;
+			bus_bits(9);
+			rx_data[i] = panel_read(panel);
+		}
+	}
+
+	bus_bits(1);								// STOP
+	return SUCCESS;
+}
+
+static void panel_write(emulator_panel* panel, uint8_t value) {
+	bool e_was = static_cast<bool>(panel->port & E);
+	bool e_now = static_cast<bool>(value & E);
+
+	// Read cycle: the controller drives the next nibble while E is high //
+	if (!e_was && e_now && static_cast<bool>(value & RW)) {
+		uint8_t ac = panel->cgram_mode ? panel->ac : static_cast<uint8_t>((panel->ac < LINE_LENGTH) ? panel->ac : 0x40 + panel->ac - LINE_LENGTH);
+		uint8_t status = static_cast<uint8_t>((now_ns < panel->busy_until_ns ? 0x80 : 0x00) | ac);
+		panel->read_nibble = panel->read_low ? static_cast<uint8_t>(status & 0x0F) : static_cast<uint8_t>(status >> 4);
+		panel->read_low = !panel->read_low;
+	}
+
+	// Write cycle: falling edge of E latches D7 - D4 //
+	if (e_was && !e_now && !static_cast<bool>(panel->port & RW))
+		panel_latch(panel, static_cast<uint8_t>(panel->port >> 4), static_cast<bool>(panel->port & RS));
+
+	panel->port = value;
+}
+
+// Quasi-bidirectional port: released pins (written high) show the level driven by the controller //
+static uint8_t panel_read(emulator_panel* panel) {
+	if (static_cast<bool>(panel->port & E) && static_cast<bool>(panel->port & RW))
+		return static_cast<uint8_t>(panel->port & ((panel->read_nibble << 4) | 0x0F));
+	return panel->port;
+}
+
+static void panel_latch(emulator_panel* panel, uint8_t nibble, bool rs) {
+
+	// 8-bit mode: DB3 - DB0 are not connected and read as 0 //
+	if (!panel->four_bit) {
+		panel_execute(panel, static_cast<uint8_t>(nibble << 4), rs);
+		return;
+	}
+
+	if (!panel->nibble_pending) {
+		panel->high_nibble = nibble;
+		panel->nibble_pending = true;
+		return;
+	}
+	panel->nibble_pending = false;
+	panel_execute(panel, static_cast<uint8_t>((panel->high_nibble << 4) | nibble), rs);
+}
+
+static void panel_execute(emulator_panel* panel, uint8_t data, bool rs) {
+
+	if (now_ns < panel->busy_until_ns)
+		stats.busy_violations++;
+	uint32_t execution_ns = EXECUTION_TIME_NS;
+	panel->read_low = false;
+
+	if (rs) {
+		stats.characters++;
+		if (panel->cgram_mode) {
+			panel->cgram[panel->ac] = static_cast<uint8_t>(data & 0x1F);
+			panel->ac = static_cast<uint8_t>((panel->ac + (panel->increment ? 1 : CGRAM_SIZE - 1)) % CGRAM_SIZE);
+		}
+		else {
+			panel->ddram[panel->ac] = static_cast<char>(data);
+			panel->ac = panel_step(panel->ac, panel->increment);
+			if (panel->entry_shift)
+				panel->shift = static_cast<uint8_t>((panel->shift + (panel->increment ? 1 : LINE_LENGTH - 1)) % LINE_LENGTH);
+		}
+		panel->busy_until_ns = now_ns + execution_ns;
+		return;
+	}
+
+	stats.instructions++;
+	if (data & 0x80) {							// Set DDRAM address
+		uint8_t address = static_cast<uint8_t>(data & 0x7F);
+		panel->cgram_mode = false;
+		panel->ac = (address >= 0x40) ? static_cast<uint8_t>(LINE_LENGTH + (address - 0x40) % LINE_LENGTH) : static_cast<uint8_t>(address % LINE_LENGTH);
+	}
+	else if (data & 0x40) {						// Set CGRAM address
+		panel->cgram_mode = true;
+		panel->ac = static_cast<uint8_t>(data & 0x3F);
+	}
+	else if (data & 0x20) {						// Function set
+		panel->four_bit = !static_cast<bool>(data & 0x10);
+		panel->nibble_pending = false;
+	}
+	else if (data & 0x10) {						// Cursor / display shift
+		bool right = static_cast<bool>(data & 0x04);
+		if (data & 0x08)
+			panel->shift = static_cast<uint8_t>((panel->shift + (right ? LINE_LENGTH - 1 : 1)) % LINE_LENGTH);
+		else if (!panel->cgram_mode)
+			panel->ac = panel_step(panel->ac, right);
+	}
+	else if (data & 0x08) {						// Display on / off control
+		panel->display_on = static_cast<bool>(data & 0x04);
+	}
+	else if (data & 0x04) {						// Entry mode set
+		panel->increment = static_cast<bool>(data & 0x02);
+		panel->entry_shift = static_cast<bool>(data & 0x01);
+	}
+	else if (data & 0x02) {						// Return home
+		panel->ac = 0;
+		panel->shift = 0;
+		panel->cgram_mode = false;
+		execution_ns = LONG_EXECUTION_NS;
+	}
+	else if (data & 0x01) {						// Clear display
+		for (uint8_t i = 0; i < DDRAM_SIZE; i++)
+			panel->ddram[i] = ' ';
+		panel->ac = 0;
+		panel->shift = 0;
+		panel->increment = true;
+		panel->cgram_mode = false;
+		execution_ns = LONG_EXECUTION_NS;
+	}
+
+	panel->busy_until_ns = now_ns + execution_ns;
+}
+
+// Next DDRAM index in 2 line mode: 0x27 is followed by 0x40, 0x67 by 0x00 //
+static uint8_t panel_step(uint8_t index, bool increment) {
+	if (increment)
+		return static_cast<uint8_t>((index + 1) % DDRAM_SIZE);
+	return static_cast<uint8_t>((index + DDRAM_SIZE - 1) % DDRAM_SIZE);
+}
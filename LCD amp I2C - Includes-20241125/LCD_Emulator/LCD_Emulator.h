@@ -0,0 +1,80 @@
+/*
+ ***********************************************************************************
+ * @file:   LCD_Emulator.h
+ * @date:   16.10.2026
+ *
+ * Workstation model of the HW-061 module (PCF8574 I/O expander + HD44780 controller).
+ * It replaces the AVR128DB48_I2C module: the i2c_* functions are implemented here, so
+ * I2C_LCD.cpp and the LCD examples run unchanged on Linux (with the headers in host/).
+ *
+ * The expander states are decoded like the real panel sees them: a falling edge of E
+ * latches D7 - D4, the controller starts in 8-bit mode (init sequence) and executes
+ * instructions / data writes into a DDRAM and CGRAM model. Reads return the busy flag
+ * and the address counter. The visible text is rendered for any geometry.
+ *
+ * Bus cost is counted per transaction: bytes on the bus (address byte included) and the
+ * modelled time at the selected SCL frequency (9 bit times per byte + START + STOP).
+ * Delays do not wait, they advance the modelled time.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Usage:
+  1. emulator_reset() (a 16x2 panel is attached at 0x27), emulator_attach() for more panels.
+  2. Run LCD code, take the cost with emulator_takeStats() after each frame.
+  3. emulator_render() returns the visible text of a panel.
+  See LCD_Emulator_Runner.cpp for the examples and the build command.
+*/
+
+
+#ifndef LCD_EMULATOR_H_
+#define LCD_EMULATOR_H_
+
+// INCLUDES //
+#include <stdint.h>
+#include "../AVR128DB48_I2C/AVR128DB48_I2C.h"
+
+// DEFINES //
+#define EMULATOR_PANELS			8		// Panels that can be attached (PCF8574 0x20 - 0x27)
+#define EMULATOR_SCREEN_SIZE	168		// Text of the largest geometry: 4 x (40 + '\n') + '\0'
+#define EMULATOR_GLYPH_CHAR		'*'		// Rendered for CGRAM characters (see emulator_glyph())
+#define EMULATOR_BLOCK_CHAR		'#'		// Rendered for the full block (0xFF)
+
+// TYPES //
+typedef struct {
+	uint32_t	transactions;		// START ... STOP on the bus (a repeated START belongs to the transaction)
+	uint32_t	bytes;				// Bytes on the bus, address bytes included
+	uint32_t	bus_time_us;		// Modelled time on the bus
+	uint32_t	delay_time_us;		// Time in _delay_us() / _delay_ms()
+	uint32_t	instructions;		// HD44780 instructions executed
+	uint32_t	characters;			// HD44780 data writes (DDRAM or CGRAM)
+	uint32_t	busy_violations;	// Instructions that arrived while the controller was busy
+} emulator_stats;
+
+typedef void (*emulator_delay_hook)(uint32_t us);	// Called after every delay (e.g. to end an endless example)
+typedef uint8_t (*emulator_input_hook)(uint8_t port, uint8_t level);	// Returns the pin levels of PORTx.IN (port 0 = A)
+
+// FUNCTION DECLARATIONS //
+void emulator_reset(); // Removed void from parameter list for C++
+
+bool emulator_attach(uint8_t address, uint8_t columns, uint8_t rows);
+
+emulator_stats emulator_takeStats(); // Removed void from parameter list for C++
+
+uint64_t emulator_time_us(); // Removed void from parameter list for C++
+
+bool emulator_render(uint8_t address, char* screen);
+
+bool emulator_glyph(uint8_t address, uint8_t slot, uint8_t* rows);
+
+void emulator_setDelayHook(emulator_delay_hook hook);
+
+void emulator_setInputHook(emulator_input_hook hook);
+
+void emulator_delay_us(uint32_t us);
+
+#endif /* LCD_EMULATOR_H_ */
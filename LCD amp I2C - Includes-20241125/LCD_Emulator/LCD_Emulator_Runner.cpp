@@ -0,0 +1,298 @@
+/*
+ ***********************************************************************************
+ * @file:   LCD_Emulator_Runner.cpp
+ * @date:   16.10.2026
+ *
+ * Runs the LCD examples on the LCD_Emulator, compares every frame with the expected
+ * screen (golden screens) and prints the bus cost per frame.
+ * The example sources are included unchanged; endless examples are stopped from the
+ * delay / input hook with an exception once their script is done.
+ *
+ * Build and run (in this directory):
+ *   g++ -std=gnu++14 -I host -I ../I2C_LCD -I ../AVR128DB48_I2C -I ../Cycle_Counter -I ../Int_Format
+ *       LCD_Emulator_Runner.cpp LCD_Emulator.cpp ../I2C_LCD/I2C_LCD.cpp
+ *       ../Cycle_Counter/Cycle_Counter.cpp ../Int_Format/Int_Format.cpp -o lcd_emulator
+ *   ./lcd_emulator       (exit code 1 if a screen does not match)
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+*/
+
+// EXAMPLES //
+#include "../../AVR_LCD_Display_Projects/main2.cpp"		// count_up()
+#include "../../AVR_LCD_Display_Projects/main3.cpp"		// ping_pong()
+#define main binary_calculator_main
+#include "../../AVR_LCD_Display_Projects/main4.cpp"		// binary_calculator_lcd()
+#undef main
+
+#undef F_CPU
+#define main ir_timer_main
+#include "../../AVR_IR_Timer_LCD/main.cpp"				// NEC decoder + countdown
+#undef main
+
+// INCLUDES //
+#include <stdio.h>
+#include <string.h>
+#include "LCD_Emulator.h"
+
+// DEFINES //
+#define PRINT_FRAMES	3		// Golden screens printed per scenario (all frames are compared)
+
+// TYPES //
+typedef struct {
+	const char*	name;
+	uint32_t	frames;
+	uint32_t	mismatches;
+	uint32_t	bytes;
+	uint32_t	bytes_max;
+	uint32_t	transactions;
+	uint32_t	bus_time_us;
+	uint32_t	busy_violations;
+} scenario_result;
+
+typedef struct {
+	uint8_t		pressed;	// Button mask (PC4 - PC7), active low
+	int32_t		counter;	// Expected value after the button has been released
+} button_press;
+
+struct scenario_done {};	// Thrown from a hook to end an endless example
+
+// VARIABLES //
+static scenario_result result;
+static uint32_t failures = 0;
+
+// count_up() / ping_pong(): frames are taken in the delay after each update //
+static const uint32_t ping_pong_frames = 64;	// 2 cycles of 32 positions
+
+// binary_calculator_lcd(): button script //
+static const button_press calculator_script[] = {
+	{PIN4_bm, 1}, {PIN4_bm, 2}, {PIN4_bm, 3},	// +1 +1 +1
+	{PIN6_bm, 6}, {PIN6_bm, 12},				// << <<
+	{PIN5_bm, 11},								// -1
+	{PIN7_bm, 5},								// >>
+	{PIN5_bm, 4}, {PIN5_bm, 3}, {PIN5_bm, 2}, {PIN5_bm, 1}, {PIN5_bm, 0}, {PIN5_bm, -1}, {PIN5_bm, -2},
+	{PIN6_bm, -4}, {PIN7_bm, -2}
+};
+static const uint8_t script_reads = 12;		// PORTC.IN reads per pressed / released phase
+static uint16_t script_read = 0;
+
+// PRIVATE FUNCTIONS //
+static void print_screen(const char* screen) {
+	const char* line = screen;
+	uint8_t columns = static_cast<uint8_t>(strchr(screen, '\n') - screen);
+
+	printf("  +");
+	for (uint8_t x = 0; x < columns; x++)
+		putchar('-');
+	printf("+\n");
+	while (*line != '\0') {
+		const char* end = strchr(line, '\n');
+		printf("  |%.*s|\n", static_cast<int>(end - line), line);
+		line = end + 1;
+	}
+	printf("  +");
+	for (uint8_t x = 0; x < columns; x++)
+		putchar('-');
+	printf("+\n");
+}
+
+// Builds a 16x2 screen from the text of both rows (padded with spaces) //
+static void make_screen(char* screen, const char* row0, const char* row1) {
+	snprintf(screen, EMULATOR_SCREEN_SIZE, "%-16.16s\n%-16.16s\n", row0, row1);
+}
+
+static void begin_scenario(const char* name) {
+	emulator_reset();
+	emulator_setDelayHook(0);
+	emulator_setInputHook(0);
+
+	lcd_select(0);
+	lcd_setup(lcd_selected(), 0x27, LCD_16X2);
+	lcd_init();
+	emulator_takeStats();		// Only the frames are counted
+
+	result = scenario_result();
+	result.name = name;
+	printf("%s\n", name);
+}
+
+// Takes the cost of one frame and compares the screen //
+static void check_frame(const char* expected) {
+	char screen[EMULATOR_SCREEN_SIZE];
+	emulator_stats stats = emulator_takeStats();
+	emulator_render(0x27, screen);
+
+	result.bytes += stats.bytes;
+	if (stats.bytes > result.bytes_max)
+		result.bytes_max = stats.bytes;
+	result.transactions += stats.transactions;
+	result.bus_time_us += stats.bus_time_us;
+	result.busy_violations += stats.busy_violations;
+
+	bool match = (strcmp(screen, expected) == 0);
+	if (!match)
+		result.mismatches++;
+	if (result.frames < PRINT_FRAMES || !match) {
+		printf(" frame %lu: %lu bytes, %lu transactions, %lu us%s\n", static_cast<unsigned long>(result.frames),
+			static_cast<unsigned long>(stats.bytes), static_cast<unsigned long>(stats.transactions),
+			static_cast<unsigned long>(stats.bus_time_us), match ? "" : "  MISMATCH, expected:");
+		if (!match)
+			print_screen(expected);
+		print_screen(screen);
+	}
+	result.frames++;
+}
+
+static void end_scenario() {
+	uint32_t frames = (result.frames != 0) ? result.frames : 1;
+	printf(" %lu frames, bytes/frame avg %lu max %lu, transactions/frame %lu.%02lu, bus time/frame %lu us, busy violations %lu -> %s\n\n",
+		static_cast<unsigned long>(result.frames),
+		static_cast<unsigned long>(result.bytes / frames), static_cast<unsigned long>(result.bytes_max),
+		static_cast<unsigned long>(result.transactions / frames), static_cast<unsigned long>(result.transactions * 100 / frames % 100),
+		static_cast<unsigned long>(result.bus_time_us / frames), static_cast<unsigned long>(result.busy_violations),
+		(result.mismatches == 0 && result.busy_violations == 0) ? "OK" : "FAILED");
+
+	if (result.mismatches != 0 || result.busy_violations != 0)
+		failures++;
+}
+
+// count_up(): the delay after each flush shows the current number //
+static void count_up_delay(uint32_t us) {
+	if (us != WAIT * 1000UL)
+		return;
+	char number[12];
+	char screen[EMULATOR_SCREEN_SIZE];
+	snprintf(number, sizeof(number), "%lu", static_cast<unsigned long>(result.frames));
+	make_screen(screen, number, "");
+	check_frame(screen);
+}
+
+// ping_pong(): position j of a cycle is column j of row 0, then columns 15 - 0 of row 1 //
+static void ping_pong_delay(uint32_t us) {
+	if (us != WAIT * 1000UL)
+		return;
+	if (result.frames == ping_pong_frames)
+		throw scenario_done();
+
+	uint32_t step = result.frames % (2 * LCD_WIDTH);
+	uint8_t row = (step < LCD_WIDTH) ? 0 : 1;
+	uint8_t column = static_cast<uint8_t>((row == 0) ? step : 2 * LCD_WIDTH - 1 - step);
+	char line[LCD_WIDTH + 1];
+	char screen[EMULATOR_SCREEN_SIZE];
+
+	memset(line, '0', LCD_WIDTH);
+	line[LCD_WIDTH] = '\0';
+	line[column] = '1';
+	make_screen(screen, (row == 0) ? line : "0000000000000000", (row == 1) ? line : "0000000000000000");
+	check_frame(screen);
+}
+
+// binary_calculator_lcd(): each press is held and released for script_reads reads of PORTC.IN //
+static uint8_t calculator_input(uint8_t port, uint8_t level) {
+	if (port != 2)
+		return level;
+
+	uint8_t press = static_cast<uint8_t>(script_read / (2 * script_reads));
+	uint8_t phase = static_cast<uint8_t>(script_read % (2 * script_reads));
+	uint8_t count = sizeof(calculator_script) / sizeof(calculator_script[0]);
+
+	// Frame: last read of the released phase //
+	if (phase == 0 && press > 0) {
+		char value[12];
+		char row[LCD_WIDTH + 1];
+		char screen[EMULATOR_SCREEN_SIZE];
+		snprintf(value, sizeof(value), "%ld", static_cast<long>(calculator_script[press - 1].counter));
+		snprintf(row, sizeof(row), "Dec: %s", value);
+		make_screen(screen, row, "");
+		check_frame(screen);
+	}
+	if (press == count)
+		throw scenario_done();
+
+	script_read++;
+	if (phase < script_reads)
+		return static_cast<uint8_t>((PIN4_BIS_7) & ~calculator_script[press].pressed);
+	return PIN4_BIS_7;
+}
+
+// IR timer: NEC frame on PC3 (pulse widths in TCA0 counts = us) //
+static void ir_edge(bool rising, uint16_t width) {
+	TCA0.SINGLE.CNT = width;
+	PORTC.IN = rising ? PIN3_bm : 0;
+	PORTC_PORT_vect();
+}
+
+static void ir_send(uint8_t command) {
+	uint32_t frame = (static_cast<uint32_t>(command) << 16) | (static_cast<uint32_t>(static_cast<uint8_t>(~command)) << 8) | 0xFF;
+
+	ir_edge(true, 9000);		// Start: 9ms burst
+	ir_edge(false, 4500);
+	for (int8_t bit = 31; bit >= 0; bit--) {
+		ir_edge(true, ((frame >> bit) & 1) ? 2250 : 1125);
+		ir_edge(false, 560);
+	}
+}
+
+static void ir_check(uint16_t time) {
+	char row0[12];
+	char row1[LCD_WIDTH + 1];
+	char screen[EMULATOR_SCREEN_SIZE];
+
+	lcd_service();
+	snprintf(row0, sizeof(row0), "%u", time);
+	snprintf(row1, sizeof(row1), "ISR max: %u", isr_max_cycles);
+	make_screen(screen, row0, row1);
+	check_frame(screen);
+}
+
+// PUBLIC FUNCTIONS //
+int main() { // Changed from main(void) to int main()
+
+	begin_scenario("count_up (AVR_LCD_Display_Projects/main2.cpp)");
+	emulator_setDelayHook(count_up_delay);
+	count_up();
+	end_scenario();
+
+	begin_scenario("ping_pong (AVR_LCD_Display_Projects/main3.cpp)");
+	emulator_setDelayHook(ping_pong_delay);
+	try {
+		ping_pong();
+	}
+	catch (scenario_done&) {}
+	end_scenario();
+
+	begin_scenario("binary_calculator_lcd (AVR_LCD_Display_Projects/main4.cpp)");
+	emulator_setInputHook(calculator_input);
+	try {
+		binary_calculator_lcd();
+	}
+	catch (scenario_done&) {}
+	end_scenario();
+
+	begin_scenario("IR timer (AVR_IR_Timer_LCD/main.cpp)");
+	lcd_setRenderer(render_lcd);
+	cycle_counter_init();
+	configure_timer();
+	configure_ir_receiver();
+	sei();
+	update_lcd();
+	ir_check(0);
+	ir_send(0x1C);				// Digit: 6 s
+	ir_check(6);
+	ir_send(0x46);				// +1
+	ir_check(7);
+	ir_send(0x40);				// Start
+	for (uint16_t time = 6; time >= 4; time--) {
+		TCA0_OVF_vect();
+		ir_check(time);
+	}
+	ir_send(0x15);				// -1
+	ir_check(3);
+	end_scenario();
+
+	return (failures == 0) ? 0 : 1;
+}
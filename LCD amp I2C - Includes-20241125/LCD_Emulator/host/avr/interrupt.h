@@ -0,0 +1,23 @@
+/*
+ ***********************************************************************************
+ * @file:   interrupt.h (host)
+ * @date:   16.10.2026
+ *
+ * Stand-in for <avr/interrupt.h>: an ISR becomes a plain function the emulator
+ * script can call, sei() / cli() only set / clear the I-bit in SREG.
+ *
+ ***********************************************************************************
+*/
+
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+#define ISR(vector)	extern "C" void vector()
+
+static inline void sei() { SREG |= CPU_I_bm; }
+static inline void cli() { SREG &= static_cast<uint8_t>(~CPU_I_bm); }
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
@@ -0,0 +1,80 @@
+/*
+ ***********************************************************************************
+ * @file:   io.h (host)
+ * @date:   16.10.2026
+ *
+ * Stand-in for <avr/io.h> when the LCD examples are built for the workstation with
+ * the LCD_Emulator. Only the registers and bits used by the LCD modules and examples
+ * exist; they are plain variables (defined in LCD_Emulator.cpp) without hardware behaviour.
+ * Reads of PORTx.IN call the input hook of the emulator, so scripts can press buttons.
+ *
+ ***********************************************************************************
+*/
+
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+#include <stdint.h>
+
+// Input register: reading it asks the emulator for the current pin levels //
+struct host_port_input {
+	volatile uint8_t value;
+	operator uint8_t() const;
+	host_port_input& operator=(uint8_t level) { value = level; return *this; }
+};
+
+typedef struct {
+	volatile uint8_t DIR, DIRSET, DIRCLR, DIRTGL, OUT, OUTSET, OUTCLR, OUTTGL;
+	host_port_input IN;
+	volatile uint8_t INTFLAGS, PORTCTRL;
+	volatile uint8_t PIN0CTRL, PIN1CTRL, PIN2CTRL, PIN3CTRL, PIN4CTRL, PIN5CTRL, PIN6CTRL, PIN7CTRL;
+} PORT_t;
+
+typedef struct {
+	volatile uint8_t CTRLA, CTRLB, CTRLC, CTRLD, EVCTRL, INTCTRL, INTFLAGS;
+	volatile uint16_t CNT, PER, CMP0, CMP1, CMP2;
+} TCA_SINGLE_t;
+
+typedef struct {
+	TCA_SINGLE_t SINGLE;
+} TCA_t;
+
+typedef struct {
+	volatile uint8_t CTRLA, CTRLB, EVCTRL, INTCTRL, INTFLAGS, STATUS;
+	volatile uint16_t CNT, CCMP;
+} TCB_t;
+
+typedef struct {
+	volatile uint8_t SREG;
+} CPU_t;
+
+extern PORT_t PORTA, PORTB, PORTC, PORTD, PORTE, PORTF;
+extern TCA_t TCA0, TCA1;
+extern TCB_t TCB0, TCB1, TCB2, TCB3;
+extern CPU_t CPU;
+
+#define SREG	CPU.SREG
+#define CPU_I_bm	0x80
+
+#define PIN0_bm	0x01
+#define PIN1_bm	0x02
+#define PIN2_bm	0x04
+#define PIN3_bm	0x08
+#define PIN4_bm	0x10
+#define PIN5_bm	0x20
+#define PIN6_bm	0x40
+#define PIN7_bm	0x80
+
+#define PORT_PULLUPEN_bm		0x08
+#define PORT_ISC_BOTHEDGES_gc	0x01
+
+#define TCA_SINGLE_ENABLE_bm		0x01
+#define TCA_SINGLE_CLKSEL_DIV4_gc	0x04
+#define TCA_SINGLE_OVF_bm			0x01
+
+#define TCB_ENABLE_bm		0x01
+#define TCB_CLKSEL_DIV1_gc	0x00
+#define TCB_CNTMODE_INT_gc	0x00
+
+#endif /* HOST_AVR_IO_H_ */
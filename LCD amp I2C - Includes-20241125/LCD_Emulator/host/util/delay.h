@@ -0,0 +1,23 @@
+/*
+ ***********************************************************************************
+ * @file:   delay.h (host)
+ * @date:   16.10.2026
+ *
+ * Stand-in for <util/delay.h>: delays return at once and advance the modelled time
+ * of the LCD_Emulator instead.
+ *
+ ***********************************************************************************
+*/
+
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+#include <stdint.h>
+
+void emulator_delay_us(uint32_t us);
+
+static inline void _delay_us(double us) { emulator_delay_us(static_cast<uint32_t>(us)); }
+static inline void _delay_ms(double ms) { emulator_delay_us(static_cast<uint32_t>(ms * 1000.0)); }
+
+#endif /* HOST_UTIL_DELAY_H_ */
@@ -0,0 +1,307 @@
+/*
+ ***********************************************************************************
+ * @file:   Melody_Sequencer.cpp
+ * @date:   16.10.2026
+ *
+ * This module plays queued melodies from the TCA1 tick interrupt on a DDS voice
+ * (see Melody_Sequencer.h).
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+ */
+
+// INCLUDES //
+#include "Melody_Sequencer.h"
+#include "DDS_Tone.h"
+#include <avr/interrupt.h>
+#include "No_Float.h"
+#ifndef F_CPU
+#define F_CPU 4000000
+#endif
+
+// DEFINES //
+#define MELODY_TIMER	TCA1.SINGLE
+
+static_assert(F_CPU % NOTE_TICK_RATE == 0, "F_CPU must be a multiple of NOTE_TICK_RATE for an exact tick");
+static_assert(F_CPU / NOTE_TICK_RATE <= 0x10000UL, "NOTE_TICK_RATE too low for the 16-bit timer");
+
+// TYPES //
+typedef struct {
+	const song*		melody;
+	const uint16_t*	frequencies;	// Note set of the melody (note_table<...>::frequency)
+	const uint32_t*	tunings;		// Tuning words of the note set (note_table<...>::tuning)
+	uint8_t			notes;			// Size of the note set
+	uint16_t		beat;			// Ticks per beat (note_beat_ticks(bpm))
+} melody_entry;
+
+// VARIABLES //
+static volatile melody_entry	queue[MELODY_QUEUE_SIZE];
+static volatile uint8_t			queue_head = 0;		// Playing melody
+static volatile uint8_t			queue_count = 0;	// Queued melodies including the playing one
+
+static volatile uint8_t			note_index = 0;		// Note of the playing melody
+static volatile uint16_t		remaining = 0;		// Ticks until the next step (gap or next note)
+static volatile uint16_t		gap = 0;			// Silent ticks at the end of the note, 0: already silent
+static volatile bool			sounding = false;	// Note of the melody voice sounds
+static volatile uint32_t		tuning = 0;			// Tuning word of the current note (for melody_resume())
+static volatile bool			paused = false;
+static volatile bool			looping = false;
+
+
+// PRIVATE FUNCTIONS //
+/*
+*	Tuning word of a tone from the note set of a queue entry.
+*
+*	@return uint32_t Tuning word, 0 if the tone is not in the set
+*/
+static uint32_t find_tuning(const volatile melody_entry& entry, uint16_t tone) {
+	for (uint8_t position = 0; position < entry.notes; position++) {
+		if (entry.frequencies[position] == tone)
+			return entry.tunings[position];
+	}
+	return 0;
+}
+
+/*
+*	Starts the note note_index of the playing melody (interrupts disabled).
+*/
+static void start_note() {
+	const song* melody = queue[queue_head].melody;
+	uint16_t duration = static_cast<uint16_t>(queue[queue_head].beat * melody->tone_length[note_index]);
+	if (duration == 0)
+		duration = 1;
+
+	uint16_t silent = duration / 2;
+	if (silent > MELODY_GAP_MS)
+		silent = MELODY_GAP_MS;
+
+	uint16_t tone = melody->tone[note_index];
+	if (tone == mute) {
+		dds_noteOff(MELODY_KEY);
+		sounding = false;
+		remaining = duration;
+		gap = 0;
+	} else {
+		tuning = find_tuning(queue[queue_head], tone);	// Table lookup, checked by melody_queue()
+		dds_noteOn(MELODY_KEY, tuning);
+		sounding = true;
+		remaining = duration - silent;
+		gap = silent;
+	}
+}
+
+/*
+*	Advances to the next note; at the end of a melody to the next queued one
+*	(looping: the finished melody is queued again). Interrupts disabled.
+*/
+static void next_note() {
+	note_index++;
+	if (note_index < queue[queue_head].melody->length) {
+		start_note();
+		return;
+	}
+
+	// Looping: the finished entry moves to the tail (the slot is free, the queue did not grow) //
+	uint8_t finished = queue_head;
+	queue_head = (queue_head + 1) % MELODY_QUEUE_SIZE;
+	queue_count--;
+	if (looping) {
+		uint8_t tail = (queue_head + queue_count) % MELODY_QUEUE_SIZE;
+		if (tail != finished) {
+			queue[tail].melody = queue[finished].melody;
+			queue[tail].frequencies = queue[finished].frequencies;
+			queue[tail].tunings = queue[finished].tunings;
+			queue[tail].notes = queue[finished].notes;
+			queue[tail].beat = queue[finished].beat;
+		}
+		queue_count++;
+	}
+
+	note_index = 0;
+	if (queue_count != 0) {
+		start_note();
+	} else {
+		dds_noteOff(MELODY_KEY);
+		sounding = false;
+	}
+}
+
+
+// PUBLIC FUNCTIONS //
+/*
+*	Starts the 1ms tick (TCA1 overflow at NOTE_TICK_RATE). Call dds_init() too.
+*
+*	@param None
+*	@return None
+*/
+void melody_init() {
+	queue_head = 0;
+	queue_count = 0;
+	paused = false;
+	looping = false;
+	sounding = false;
+
+	MELODY_TIMER.CTRLA = 0;
+	MELODY_TIMER.CNT = 0;
+	MELODY_TIMER.PER = static_cast<uint16_t>(F_CPU / NOTE_TICK_RATE - 1);
+	MELODY_TIMER.INTCTRL = TCA_SINGLE_OVF_bm;
+	MELODY_TIMER.CTRLA = TCA_SINGLE_CLKSEL_DIV1_gc | TCA_SINGLE_ENABLE_bm;
+}
+
+/*
+*	Appends a melody to the queue. If nothing is playing it starts immediately
+*	(and a pause is ended). Usually called as melody_queue<note_table<...>>(melody).
+*
+*	@param melody Melody, must stay valid while it is queued
+*	@param frequencies Note set (compile-time table, e.g. note_table<...>::frequency)
+*	@param tunings Tuning words of the note set (note_table<...>::tuning)
+*	@param notes Size of the note set
+*	@return bool false if the queue is full, the melody is empty or a tone is not in the note set
+*/
+bool melody_queue(const song* melody, const uint16_t* frequencies, const uint32_t* tunings, uint8_t notes) {
+	if (melody == 0 || melody->length == 0 || melody->bpm == 0)
+		return false;
+
+	// Every tone must be in the table: the tick only looks up, it never computes a tuning word //
+	for (uint8_t i = 0; i < melody->length; i++) {
+		uint16_t tone = melody->tone[i];
+		uint8_t position = 0;
+		while (position < notes && frequencies[position] != tone)
+			position++;
+		if (tone != mute && position == notes)
+			return false;
+	}
+
+	uint16_t beat = note_beat_ticks(melody->bpm);	// Division here, not in the tick
+
+	bool queued = false;
+	uint8_t sreg = SREG;
+	cli();
+	if (queue_count < MELODY_QUEUE_SIZE) {
+		uint8_t tail = (queue_head + queue_count) % MELODY_QUEUE_SIZE;
+		queue[tail].melody = melody;
+		queue[tail].frequencies = frequencies;
+		queue[tail].tunings = tunings;
+		queue[tail].notes = notes;
+		queue[tail].beat = beat;
+		queue_count++;
+		queued = true;
+
+		if (queue_count == 1) {
+			paused = false;
+			note_index = 0;
+			start_note();
+		}
+	}
+	SREG = sreg;
+	return queued;
+}
+
+/*
+*	Loop mode: a finished melody is queued again, the queue repeats endlessly.
+*
+*	@param enable true: repeat, false: stop after the queue
+*	@return None
+*/
+void melody_loop(bool enable) {
+	looping = enable;
+}
+
+/*
+*	Holds the melody at the current position and silences it.
+*
+*	@param None
+*	@return None
+*/
+void melody_pause() {
+	uint8_t sreg = SREG;
+	cli();
+	paused = true;
+	dds_noteOff(MELODY_KEY);
+	SREG = sreg;
+}
+
+/*
+*	Continues a paused melody with the rest of the interrupted note.
+*
+*	@param None
+*	@return None
+*/
+void melody_resume() {
+	uint8_t sreg = SREG;
+	cli();
+	if (paused && queue_count != 0 && sounding)
+		dds_noteOn(MELODY_KEY, tuning);
+	paused = false;
+	SREG = sreg;
+}
+
+/*
+*	Ends the playing melody and empties the queue.
+*
+*	@param None
+*	@return None
+*/
+void melody_stop() {
+	uint8_t sreg = SREG;
+	cli();
+	queue_count = 0;
+	paused = false;
+	sounding = false;
+	dds_noteOff(MELODY_KEY);
+	SREG = sreg;
+}
+
+/*
+*	@param None
+*	@return bool true while a melody is queued (also when paused)
+*/
+bool melody_playing() {
+	return queue_count != 0;
+}
+
+/*
+*	@param None
+*	@return bool true if paused
+*/
+bool melody_paused() {
+	return paused;
+}
+
+/*
+*	@param None
+*	@return uint8_t Queued melodies including the playing one
+*/
+uint8_t melody_queued() {
+	return queue_count;
+}
+
+
+// INTERRUPTS //
+/*
+*	Tick: counts down the current note, silences it for the gap and starts the next note.
+*/
+ISR(TCA1_OVF_vect) {
+	MELODY_TIMER.INTFLAGS = TCA_SINGLE_OVF_bm;
+	if (paused || queue_count == 0)
+		return;
+
+	if (remaining > 1) {
+		remaining--;
+		return;
+	}
+
+	if (gap != 0) {
+		dds_noteOff(MELODY_KEY);
+		sounding = false;
+		remaining = gap;
+		gap = 0;
+		return;
+	}
+
+	next_note();
+}
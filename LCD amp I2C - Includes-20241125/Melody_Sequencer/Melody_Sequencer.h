@@ -0,0 +1,88 @@
+/*
+ ***********************************************************************************
+ * @file:   Melody_Sequencer.h
+ * @date:   16.10.2026
+ *
+ * Plays melodies of type song (song.h) in the background. A 1ms tick (TCA1 overflow
+ * interrupt) counts down the current note and switches to the next one inside the
+ * interrupt, the tones are played by DDS_Tone. The main loop stays free: it only queues
+ * melodies and may pause, resume or stop them at any time.
+ *
+ * Timing: one beat lasts note_beat_ticks(bpm) ms (Note_Table.h, computed once when the
+ * melody is queued), a note tone_length[i] beats. Articulation: the last MELODY_GAP_MS of
+ * every note are silent (at most half of the note), so repeated notes are heard separately
+ * while the tempo stays exact. A tone of 0 (mute) is a rest.
+ *
+ * Pitch: the tuning words come from a compile-time note_table (Note_Table.h) that is passed
+ * with the melody. melody_queue() checks that every tone of the melody is in the table, the
+ * tick then only looks the tuning word up (no multiplication or division per note).
+ *
+ * The melody plays on its own DDS voice (dds_noteOn() with key MELODY_KEY), the remaining
+ * voices stay free for e.g. a keyboard.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Connections:
+  Tone output see DDS_Tone.h (DAC0, PD6).
+  Uses TCA1 (overflow interrupt, 1ms) as tick.
+
+  Usage:
+  1. Call dds_init() and melody_init(), then sei().
+  2. typedef note_table<mute, c, d, e, f, g, a, h, a1> song_notes;   // notes of song.h
+     melody_queue<song_notes>(&mario) starts the melody (or appends it if one is playing).
+  3. Optional: melody_loop(true) repeats the queue endlessly,
+     melody_pause() / melody_resume(), melody_stop() ends and empties the queue.
+  4. melody_playing() is false when the queue has been played.
+*/
+
+
+#ifndef MELODY_SEQUENCER_H_
+#define MELODY_SEQUENCER_H_
+
+// INCLUDES //
+#include <avr/io.h>
+#include <stdbool.h> // Keep for bool type if not using C++ <cstdbool>
+#include "song.h"
+#include "Note_Table.h"
+
+
+// DEFINES //
+#ifndef MELODY_QUEUE_SIZE
+#define MELODY_QUEUE_SIZE	4		// Melodies that can be queued (including the playing one)
+#endif
+
+#ifndef MELODY_GAP_MS
+#define MELODY_GAP_MS		50		// Silence at the end of every note
+#endif
+
+#define MELODY_KEY			0xF0	// Key number of the melody voice (dds_noteOn())
+
+
+// FUNCTION DECLARATIONS //
+void melody_init(); // Removed void from parameter list for C++
+bool melody_queue(const song* melody, const uint16_t* frequencies, const uint32_t* tunings, uint8_t notes);
+void melody_loop(bool enable);
+void melody_pause(); // Removed void from parameter list for C++
+void melody_resume(); // Removed void from parameter list for C++
+void melody_stop(); // Removed void from parameter list for C++
+bool melody_playing(); // Removed void from parameter list for C++
+bool melody_paused(); // Removed void from parameter list for C++
+uint8_t melody_queued(); // Removed void from parameter list for C++
+
+/*
+*	Appends a melody whose tones are taken from the note set Notes (note_table<...>).
+*
+*	@param melody Melody, must stay valid while it is queued
+*	@return bool false if the queue is full, the melody is empty or a tone is not in Notes
+*/
+template <typename Notes>
+inline bool melody_queue(const song* melody) {
+	return melody_queue(melody, Notes::frequency, Notes::tuning, Notes::count);
+}
+
+#endif /* MELODY_SEQUENCER_H_ */
@@ -0,0 +1,39 @@
+/*
+ ***********************************************************************************
+ * @file:   No_Float.h
+ * @date:   16.10.2026
+ *
+ * Guard against floating point. The AVR has no FPU, every float operation pulls in the
+ * soft-float library (__divsf3, __mulsf3, ...) and costs hundreds of cycles, too much for a
+ * sample interrupt.
+ *
+ * This header is only an early hint: after it the identifiers float and double are poisoned,
+ * a later use in the same translation unit is a compile error. It does NOT catch float
+ * constants (x * 0.5f, 60000UL / (bpm * 1.0)) nor modules that do not include it. The actual
+ * guarantee is the link-time check no_float_check.sh, which fails if a soft-float routine is
+ * in the linked ELF.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Usage:
+  Include it as the LAST header, after the system headers (<util/delay.h> uses double for
+  its compile-time delay computation, that is fine as long as it is included before):
+    #include <util/delay.h>
+    #include "DDS_Tone.h"
+    #include "No_Float.h"
+  Post-build step of every program that includes it (exit code 1 if soft-float was linked):
+    sh no_float_check.sh program.elf
+*/
+
+
+#ifndef NO_FLOAT_H_
+#define NO_FLOAT_H_
+
+#pragma GCC poison float double
+
+#endif /* NO_FLOAT_H_ */
@@ -0,0 +1,37 @@
+#!/bin/sh
+#
+# @file:   no_float_check.sh
+# @date:   17.10.2026
+#
+# Link-time guard of No_Float.h: fails if the soft-float library of avr-gcc (or the float
+# routines of avr-libc) reached the linked program. Unlike the pragma in No_Float.h this
+# covers every linked module and also float constants such as 0.5f or 1.0.
+#
+# Usage (post-build step, e.g. Microchip Studio -> Build Events, MSYS2 / Cygwin shell):
+#   sh no_float_check.sh program.elf
+#   AVR_NM=/path/to/avr-nm sh no_float_check.sh program.elf
+#
+# Exit code 0: no soft-float routine, 1: soft-float found (listed), 2: usage / nm error.
+#
+# Mikroprozessortechnik
+# Technische Hochschule Mittelhessen
+#
+
+NM="${AVR_NM:-avr-nm}"
+
+if [ $# -ne 1 ] || [ ! -f "$1" ]; then
+	echo "usage: $0 program.elf" >&2
+	exit 2
+fi
+
+symbols=$("$NM" --defined-only "$1") || exit 2
+
+# __addsf3, __mulsf3, __divsf3, __fixunssfsi, __floatunsisf, ... (sf: float, df: 64-bit double)
+found=$(echo "$symbols" | awk '{ print $NF }' | grep -E '^(__(add|sub|mul|div|neg|cmp|eq|ne|lt|le|gt|ge|unord)[sd]f[23]|__fix(uns)?[sd]f[sd]i|__float(un)?[sd]i[sd]f|__(extend|trunc)[sd]f[sd]f2|__fp_[a-z_]+)$')
+
+if [ -n "$found" ]; then
+	echo "$1: soft-float routines linked (see No_Float.h):" >&2
+	echo "$found" | sed 's/^/  /' >&2
+	exit 1
+fi
+exit 0
@@ -0,0 +1,108 @@
+/*
+ ***********************************************************************************
+ * @file:   Note_Table.h
+ * @date:   16.10.2026
+ *
+ * Compile-time tables for a note set (e.g. the notes of song.h): DDS tuning words
+ * (see DDS_Tone.h) and note durations in timer ticks. Everything is constexpr and integer,
+ * the compiler puts the finished numbers into the binary; at run time a note only costs a
+ * table lookup, no division and no soft-float (former method: TCA_PER(x) and
+ * NOTE_DURATION_MS() divided in float on every note, partly inside interrupts).
+ * No_Float.h flags float / double in the source early, no_float_check.sh (No_Float)
+ * verifies after linking that no soft-float routine reached the target binary.
+ *
+ * The module is header only.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Usage:
+  typedef note_table<mute, c, d, e, f, g, a, h, a1> song_notes;   // notes of song.h
+  dds_play(0, song_notes::tuning[2]);                            // third note of the set
+  dds_play(0, song_notes::tuning_of(melody->tone[i]));           // lookup of a frequency
+  uint16_t beat = note_beat_ticks(melody->bpm);                  // once per song
+  uint16_t duration = beat * melody->tone_length[i];             // ticks of one note
+*/
+
+
+#ifndef NOTE_TABLE_H_
+#define NOTE_TABLE_H_
+
+// INCLUDES //
+#include <stdint.h>
+#include "DDS_Tone.h"
+
+
+// DEFINES //
+#ifndef NOTE_TICK_RATE
+#define NOTE_TICK_RATE		1000UL	// Ticks per second of the duration timer (1ms)
+#endif
+
+
+// TYPES //
+/*
+*	Table of a note set. Frequencies in Hz, 0 (mute) gives tuning word 0.
+*/
+template <uint16_t... Notes>
+struct note_table {
+	static constexpr uint8_t count = sizeof...(Notes);
+	static constexpr uint16_t frequency[count] = {Notes...};
+	static constexpr uint32_t tuning[count] = {dds_tuning_word(Notes)...};
+
+	/*
+	*	Position of a frequency in the set, evaluated by the compiler for constants.
+	*	@param hz Frequency
+	*	@param from First position to search (recursion, leave out)
+	*	@return uint8_t Position, count if the frequency is not in the set
+	*/
+	static constexpr uint8_t index(uint16_t hz, uint8_t from = 0) {
+		return (from == count || frequency[from] == hz) ? from : index(hz, static_cast<uint8_t>(from + 1));
+	}
+
+	/*
+	*	Tuning word of a frequency known only at run time: table lookup,
+	*	dds_tuning_hz() (one multiplication) for frequencies outside the set.
+	*	@param hz Frequency
+	*	@return uint32_t Phase increment per sample
+	*/
+	static uint32_t tuning_of(uint16_t hz) {
+		for (uint8_t position = 0; position < count; position++) {
+			if (frequency[position] == hz)
+				return tuning[position];
+		}
+		return dds_tuning_hz(hz);
+	}
+};
+
+template <uint16_t... Notes> constexpr uint8_t note_table<Notes...>::count;
+template <uint16_t... Notes> constexpr uint16_t note_table<Notes...>::frequency[];
+template <uint16_t... Notes> constexpr uint32_t note_table<Notes...>::tuning[];
+
+
+// FUNCTION DECLARATIONS //
+/*
+*	Ticks of one beat (rounded).
+*
+*	@param bpm Beats per minute (at least 1)
+*	@return uint16_t Ticks per beat
+*/
+constexpr uint16_t note_beat_ticks(uint16_t bpm) {
+	return static_cast<uint16_t>((60UL * NOTE_TICK_RATE + bpm / 2) / bpm);
+}
+
+/*
+*	Ticks of a note (rounded), meant for constants: evaluated by the compiler.
+*
+*	@param bpm Beats per minute (at least 1)
+*	@param beats Length of the note in beats
+*	@return uint16_t Ticks of the note
+*/
+constexpr uint16_t note_ticks(uint16_t bpm, uint8_t beats) {
+	return static_cast<uint16_t>((60UL * NOTE_TICK_RATE * beats + bpm / 2) / bpm);
+}
+
+#endif /* NOTE_TABLE_H_ */
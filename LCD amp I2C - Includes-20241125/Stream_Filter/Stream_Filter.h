@@ -0,0 +1,285 @@
+/*
+ ***********************************************************************************
+ * @file:   Stream_Filter.h
+ * @date:   16.10.2026
+ *
+ * Streaming filters for sensor values in integer arithmetic, one sample in, one value out:
+ *   moving_average<T, N>  mean of the last N samples (running sum, constant cost)
+ *   iir_filter<T, Shift>  exponential smoothing y += (x - y) / 2^Shift
+ *   median_filter<T, N>   median of the last N samples (removes single spikes)
+ *   kalman_filter<T>      first-order Kalman filter (constant value + noise)
+ *
+ * T is the sample type (8 or 16 bit, signed or unsigned), the window / shift is a template
+ * parameter, so every filter is a fixed-size object without heap. The module is header only.
+ *
+ * Cycles per sample on the target: AVR_ADC_and_Audio_Projects/main9.cpp,
+ * checks and throughput on the workstation: Stream_Filter_Host.cpp.
+ * Guide (ATmega / AVR without divider): moving_average and iir_filter cost a few ten cycles,
+ * median_filter grows with N, kalman_filter divides only until its gain has settled.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Usage:
+  moving_average<uint16_t, 16> average;     // N a power of two: the mean is a shift
+  iir_filter<uint16_t, 3> smooth;           // time constant ~8 samples
+  median_filter<uint16_t, 5> median;
+  kalman_filter<uint16_t> kalman(1, 400);   // process noise 1, measurement noise 400 (LSB^2)
+
+  smooth.reset(first_sample);               // optional, start without settling from 0
+  uint16_t value = smooth.update(sample);   // once per sample
+*/
+
+
+#ifndef STREAM_FILTER_H_
+#define STREAM_FILTER_H_
+
+// INCLUDES //
+#include <stdint.h>
+
+// DEFINES //
+#define KALMAN_STATE_SHIFT	4	// Fraction bits of the Kalman estimate
+#define KALMAN_GAIN_SHIFT	10	// Fraction bits of the Kalman gain (0 ... 1024)
+#define KALMAN_VARIANCE_SHIFT	4	// Fraction bits of the Kalman variances
+#define KALMAN_VARIANCE_MAX	0x1FFFFFUL	// Largest variance (fraction bits included), error << KALMAN_GAIN_SHIFT fits 32 bits
+
+#ifndef KALMAN_GAIN_COUNTER
+#define KALMAN_GAIN_COUNTER()		// Called on every gain division (the host check counts them)
+#endif
+
+// TYPES //
+/*
+*	Mean of the last N samples. The sum is updated by the new and the dropped sample,
+*	the cost does not depend on N. The result is rounded.
+*/
+template <typename T, uint8_t N>
+class moving_average {
+	static_assert(sizeof(T) <= 2, "moving_average: samples of at most 16 bit");
+	static_assert(N >= 1, "moving_average: window of at least one sample");
+
+public:
+	moving_average() { reset(0); }
+
+	/*
+	*	Fills the window with one value.
+	*	@param value Start value
+	*/
+	void reset(T value) {
+		for (uint8_t i = 0; i < N; i++)
+			window[i] = value;
+		sum = static_cast<int32_t>(value) * N;
+		index = 0;
+	}
+
+	/*
+	*	@param sample New sample, replaces the oldest one
+	*	@return T Mean of the window
+	*/
+	T update(T sample) {
+		sum += static_cast<int32_t>(sample) - window[index];
+		window[index] = sample;
+		if (++index == N)
+			index = 0;
+		return value();
+	}
+
+	/*
+	*	@return T Mean of the window (division by N, a shift if N is a power of two and T unsigned)
+	*/
+	T value() const {
+		return (sum >= 0)
+			? static_cast<T>((static_cast<uint32_t>(sum) + N / 2) / N)
+			: static_cast<T>((sum - N / 2) / N);
+	}
+
+private:
+	T window[N];
+	int32_t sum;
+	uint8_t index;
+};
+
+/*
+*	Exponential smoothing (first-order IIR low-pass): y += (x - y) / 2^Shift.
+*	The state keeps Shift fraction bits, so small steps are not lost and the output
+*	reaches the input exactly. A step reaches 63% after ~2^Shift samples.
+*/
+template <typename T, uint8_t Shift>
+class iir_filter {
+	static_assert(sizeof(T) <= 2, "iir_filter: samples of at most 16 bit");
+	static_assert(Shift >= 1 && Shift <= 15, "iir_filter: Shift must be 1 ... 15");
+
+public:
+	iir_filter() { reset(0); }
+
+	/*
+	*	@param value Start value
+	*/
+	void reset(T value) {
+		state = static_cast<int32_t>(value) << Shift;
+	}
+
+	/*
+	*	@param sample New sample
+	*	@return T Smoothed value
+	*/
+	T update(T sample) {
+		state += static_cast<int32_t>(sample) - static_cast<int32_t>(value());
+		return value();
+	}
+
+	/*
+	*	@return T Smoothed value (rounded)
+	*/
+	T value() const {
+		return static_cast<T>((state + (1L << (Shift - 1))) >> Shift);
+	}
+
+private:
+	int32_t state;	// Value << Shift
+};
+
+/*
+*	Median of the last N samples (N odd). The window is kept sorted: per sample the oldest
+*	value is taken out and the new one inserted, the cost grows linear with N.
+*/
+template <typename T, uint8_t N>
+class median_filter {
+	static_assert(N % 2 == 1 && N <= 31, "median_filter: N must be odd and at most 31");
+
+public:
+	median_filter() { reset(0); }
+
+	/*
+	*	@param value Start value of the whole window
+	*/
+	void reset(T value) {
+		for (uint8_t i = 0; i < N; i++) {
+			history[i] = value;
+			sorted[i] = value;
+		}
+		index = 0;
+	}
+
+	/*
+	*	@param sample New sample, replaces the oldest one
+	*	@return T Median of the window
+	*/
+	T update(T sample) {
+		T oldest = history[index];
+		history[index] = sample;
+		if (++index == N)
+			index = 0;
+
+		// Position of the oldest value in the sorted window //
+		uint8_t position = 0;
+		while (sorted[position] != oldest)
+			position++;
+
+		// Move the gap to the place of the new sample //
+		while (position > 0 && sorted[position - 1] > sample) {
+			sorted[position] = sorted[position - 1];
+			position--;
+		}
+		while (position < N - 1 && sorted[position + 1] < sample) {
+			sorted[position] = sorted[position + 1];
+			position++;
+		}
+		sorted[position] = sample;
+
+		return value();
+	}
+
+	/*
+	*	@return T Median of the window
+	*/
+	T value() const {
+		return sorted[N / 2];
+	}
+
+private:
+	T history[N];	// Samples in arrival order
+	T sorted[N];	// Same samples, ascending
+	uint8_t index;	// Oldest sample in history
+};
+
+/*
+*	First-order Kalman filter for a value that changes slowly (random walk) and is measured
+*	with noise. process_noise and measurement_noise are variances in LSB^2: the larger the
+*	ratio measurement / process, the smoother (and slower) the output.
+*
+*	Fixed point: estimate, gain and variances with KALMAN_STATE_SHIFT, KALMAN_GAIN_SHIFT and
+*	KALMAN_VARIANCE_SHIFT fraction bits (without fraction bits the truncated variance would
+*	settle too high). The gain needs a division; it is only computed while the error variance
+*	changes, once the filter has settled (after some ten samples) an update costs two
+*	multiplications. Gains below 1/1024 round to 0: process / measurement noise above ~1/1000000.
+*/
+template <typename T>
+class kalman_filter {
+	static_assert(sizeof(T) <= 2, "kalman_filter: samples of at most 16 bit");
+
+public:
+	/*
+	*	@param process_noise Variance of the change per sample (LSB^2, at least 1)
+	*	@param measurement_noise Variance of the noise of one sample (LSB^2)
+	*/
+	kalman_filter(uint16_t process_noise, uint16_t measurement_noise)
+		: q(static_cast<uint32_t>(process_noise) << KALMAN_VARIANCE_SHIFT),
+		  r(static_cast<uint32_t>(measurement_noise) << KALMAN_VARIANCE_SHIFT) { reset(0); }
+
+	/*
+	*	Starts from a value with the uncertainty of one measurement.
+	*	@param value Start value
+	*/
+	void reset(T value) {
+		estimate = static_cast<int32_t>(value) << KALMAN_STATE_SHIFT;
+		error = r;
+		gain_error = 0;
+		gain = 0;
+	}
+
+	/*
+	*	@param sample New measurement
+	*	@return T Estimate
+	*/
+	T update(T sample) {
+		// Predict: the value may have moved by the process noise //
+		error += q;
+		if (error > KALMAN_VARIANCE_MAX)
+			error = KALMAN_VARIANCE_MAX;
+
+		// Gain = error / (error + r), only when the error variance changed //
+		if (error != gain_error) {
+			gain = static_cast<uint16_t>((error << KALMAN_GAIN_SHIFT) / (error + r));
+			gain_error = error;
+			KALMAN_GAIN_COUNTER();
+		}
+
+		// Correct //
+		int32_t innovation = (static_cast<int32_t>(sample) << KALMAN_STATE_SHIFT) - estimate;
+		estimate += (innovation * gain + (1L << (KALMAN_GAIN_SHIFT - 1))) >> KALMAN_GAIN_SHIFT;
+		error -= (error * gain + (1UL << (KALMAN_GAIN_SHIFT - 1))) >> KALMAN_GAIN_SHIFT;
+
+		return value();
+	}
+
+	/*
+	*	@return T Estimate (rounded)
+	*/
+	T value() const {
+		return static_cast<T>((estimate + (1L << (KALMAN_STATE_SHIFT - 1))) >> KALMAN_STATE_SHIFT);
+	}
+
+private:
+	uint32_t q;				// Process noise (LSB^2 << KALMAN_VARIANCE_SHIFT)
+	uint32_t r;				// Measurement noise (LSB^2 << KALMAN_VARIANCE_SHIFT)
+	int32_t estimate;		// Value << KALMAN_STATE_SHIFT
+	uint32_t error;			// Variance of the estimate (LSB^2 << KALMAN_VARIANCE_SHIFT)
+	uint32_t gain_error;	// error of the last gain computation
+	uint16_t gain;			// error / (error + r) << KALMAN_GAIN_SHIFT
+};
+
+#endif /* STREAM_FILTER_H_ */
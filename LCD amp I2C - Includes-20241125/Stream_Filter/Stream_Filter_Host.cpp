@@ -0,0 +1,203 @@
+/*
+ ***********************************************************************************
+ * @file:   Stream_Filter_Host.cpp
+ * @date:   16.10.2026
+ *
+ * Workstation check and benchmark of the Stream_Filter module:
+ * - moving_average and median_filter are compared with a direct computation over the window,
+ * - iir_filter and kalman_filter are compared with the same filter in double precision,
+ *   the step response of iir_filter has to reach the input exactly,
+ * - the gain divisions of a settled kalman_filter are counted inside the class
+ *   (KALMAN_GAIN_COUNTER hook),
+ * - every filter is timed (throughput in samples per microsecond).
+ * The streams are a noisy slow ramp with single spikes, like a light sensor.
+ * Cycles per sample on the target: AVR_ADC_and_Audio_Projects/main9.cpp.
+ *
+ * Build and run (in this directory):
+ *   g++ -std=gnu++14 -O2 Stream_Filter_Host.cpp -o stream_filter && ./stream_filter
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+*/
+
+// INCLUDES //
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <stdint.h>
+#include <time.h>
+
+static uint32_t kalman_divisions = 0;
+#define KALMAN_GAIN_COUNTER()	(kalman_divisions++)	// Counts the gain divisions of every kalman_filter
+#include "Stream_Filter.h"
+
+// DEFINES //
+#define STREAM_LENGTH	100000UL
+#define BENCHMARK_RUNS	100
+
+// VARIABLES //
+static uint32_t failures = 0;
+static uint32_t random_state = 0x12345678UL;
+static uint16_t stream[STREAM_LENGTH];
+
+// PRIVATE FUNCTIONS //
+static uint32_t next_random() {
+	random_state = random_state * 1664525UL + 1013904223UL;
+	return random_state >> 8;
+}
+
+// 12-bit ramp 0 ... 4095 and back, +-20 LSB noise, every 97th sample a spike //
+static void make_stream() {
+	for (uint32_t i = 0; i < STREAM_LENGTH; i++) {
+		int32_t ramp = static_cast<int32_t>((i / 8) % 8192);
+		if (ramp > 4095)
+			ramp = 8191 - ramp;
+		int32_t value = ramp + static_cast<int32_t>(next_random() % 41) - 20;
+		if (i % 97 == 0)
+			value = (value > 2048) ? 0 : 4095;
+		if (value < 0)
+			value = 0;
+		if (value > 4095)
+			value = 4095;
+		stream[i] = static_cast<uint16_t>(value);
+	}
+}
+
+static void expect(const char* filter, uint32_t index, long result, long expected, long tolerance) {
+	if (labs(result - expected) > tolerance) {
+		if (failures < 10)
+			printf("  %s[%lu]: %ld, expected %ld\n", filter, static_cast<unsigned long>(index), result, expected);
+		failures++;
+	}
+}
+
+static int compare_samples(const void* a, const void* b) {
+	return *static_cast<const uint16_t*>(a) - *static_cast<const uint16_t*>(b);
+}
+
+static void check_moving_average() {
+	moving_average<uint16_t, 16> filter;
+	for (uint32_t i = 0; i < STREAM_LENGTH; i++) {
+		long result = filter.update(stream[i]);
+		long sum = 0;
+		for (uint32_t j = 0; j < 16; j++)
+			sum += (i >= j) ? stream[i - j] : 0;
+		expect("moving_average<16>", i, result, (sum + 8) / 16, 0);
+	}
+
+	moving_average<int16_t, 5> signed_filter;
+	for (uint32_t i = 0; i < STREAM_LENGTH; i++) {
+		long result = signed_filter.update(static_cast<int16_t>(stream[i] - 2048));
+		long sum = 0;
+		for (uint32_t j = 0; j < 5; j++)
+			sum += (i >= j) ? stream[i - j] - 2048 : 0;
+		expect("moving_average<int16_t, 5>", i, result, lround(sum / 5.0), 0);
+	}
+}
+
+static void check_median() {
+	median_filter<uint16_t, 5> filter;
+	uint16_t window[5];
+	for (uint32_t i = 0; i < STREAM_LENGTH; i++) {
+		long result = filter.update(stream[i]);
+		for (uint32_t j = 0; j < 5; j++)
+			window[j] = (i >= j) ? stream[i - j] : 0;
+		qsort(window, 5, sizeof(window[0]), compare_samples);
+		expect("median_filter<5>", i, result, window[2], 0);
+	}
+}
+
+static void check_iir() {
+	iir_filter<uint16_t, 3> filter;
+	double reference = 0;
+	for (uint32_t i = 0; i < STREAM_LENGTH; i++) {
+		long result = filter.update(stream[i]);
+		reference += (stream[i] - reference) / 8.0;
+		expect("iir_filter<3>", i, result, lround(reference), 4);
+	}
+
+	// Step response ends exactly at the input //
+	iir_filter<uint16_t, 6> step;
+	for (uint32_t i = 0; i < 2000; i++)
+		step.update(1000);
+	expect("iir_filter<6> step", 0, step.value(), 1000, 0);
+	for (uint32_t i = 0; i < 2000; i++)
+		step.update(999);
+	expect("iir_filter<6> step", 1, step.value(), 999, 0);
+}
+
+static void check_kalman() {
+	kalman_filter<uint16_t> filter(1, 400);
+	double estimate = 0, error = 400;
+	for (uint32_t i = 0; i < STREAM_LENGTH; i++) {
+		long result = filter.update(stream[i]);
+		error += 1;
+		double gain = error / (error + 400);
+		estimate += gain * (stream[i] - estimate);
+		error -= gain * error;
+		if (i > 100)
+			expect("kalman_filter(1, 400)", i, result, lround(estimate), 8);
+	}
+}
+
+// Gain divisions of the settled filter, counted inside kalman_filter::update() //
+static void count_kalman_divisions() {
+	kalman_filter<uint16_t> filter(1, 400);
+	for (uint32_t i = 0; i < 100; i++)
+		filter.update(stream[i]);
+
+	kalman_divisions = 0;
+	for (uint32_t i = 100; i < 1000; i++)
+		filter.update(stream[i]);
+	uint32_t divisions = kalman_divisions;
+
+	printf("  kalman_filter(1, 400): %lu gain divisions in samples 100 ... 999\n",
+		static_cast<unsigned long>(divisions));
+	if (divisions > 10)
+		failures++;
+}
+
+template <typename Filter>
+static double benchmark(Filter& filter) {
+	uint32_t checksum = 0;
+	clock_t start = clock();
+	for (uint32_t run = 0; run < BENCHMARK_RUNS; run++)
+		for (uint32_t i = 0; i < STREAM_LENGTH; i++)
+			checksum += filter.update(stream[i]);
+	clock_t end = clock();
+	if (checksum == 1)
+		printf("  (checksum %lu)\n", static_cast<unsigned long>(checksum));
+	double us = (end - start) * 1e6 / CLOCKS_PER_SEC;
+	return (static_cast<double>(BENCHMARK_RUNS) * STREAM_LENGTH) / us;
+}
+
+int main() { // Changed from main(void) to int main()
+	make_stream();
+
+	printf("Check against direct / double computation\n");
+	check_moving_average();
+	check_median();
+	check_iir();
+	check_kalman();
+	count_kalman_divisions();
+	printf("  %s (%lu failures)\n\n", failures == 0 ? "OK" : "FAILED", static_cast<unsigned long>(failures));
+
+	moving_average<uint16_t, 16> average;
+	iir_filter<uint16_t, 3> smooth;
+	median_filter<uint16_t, 5> median5;
+	median_filter<uint16_t, 15> median15;
+	kalman_filter<uint16_t> kalman(1, 400);
+
+	printf("Throughput, samples per microsecond\n");
+	printf("  moving_average<16>: %7.1f\n", benchmark(average));
+	printf("  iir_filter<3>:      %7.1f\n", benchmark(smooth));
+	printf("  median_filter<5>:   %7.1f\n", benchmark(median5));
+	printf("  median_filter<15>:  %7.1f\n", benchmark(median15));
+	printf("  kalman_filter:      %7.1f\n", benchmark(kalman));
+
+	return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+/*
+ ***********************************************************************************
+ * @file:   Text_Format.h
+ * @date:   16.10.2026
+ *
+ * Typed text output without printf. Instead of a format string that is parsed at run
+ * time, the pieces are passed as arguments; the compiler picks the conversion of every
+ * argument from its type (variadic templates), so only the conversions that are used end
+ * up in flash and nothing is interpreted at run time. No heap, no varargs.
+ *
+ * Field formats are template parameters:
+ *   text_dec<5>(x)       decimal, right aligned in 5 characters
+ *   text_dec<4, '0'>(x)  decimal, 4 digits with leading zeros
+ *   text_hex<4>(x)       hexadecimal, 4 digits
+ *   text_bin<8>(x)       binary, 8 digits
+ *
+ * The output goes directly to a sink (any type with put(char)):
+ *   text_lcd()     screen buffer of the selected LCD (see I2C_LCD.h)
+ *   text_usart()   USART, blocking per character
+ *   text_buffer()  char array, always terminated
+ *
+ * Numbers are converted by the Int_Format module (no division, at most 32 bits).
+ * The module is header only, the templates are expanded at the call site.
+ *
+ * *********************************************************************************
+ *
+ * Mikroprozessortechnik
+ * Technische Hochschule Mittelhessen
+ *
+ ***********************************************************************************
+
+  Usage:
+  text_lcd(9, 1, "C:", clear_val);                        // instead of sprintf + lcd_bufferPutString
+  text_usart(USART3, "ADC ", text_hex<4>(value), "\r\n");
+  char buf[8]; text_buffer(buf, sizeof(buf), text_dec<3>(percent), '%');
+*/
+
+
+#ifndef TEXT_FORMAT_H_
+#define TEXT_FORMAT_H_
+
+// INCLUDES //
+#include <avr/io.h>
+#include "I2C_LCD.h"
+#include "Int_Format.h"
+
+// TYPES //
+template <uint8_t Width, char Fill>
+struct text_dec_field {
+	int32_t value;
+};
+
+template <uint8_t Digits>
+struct text_hex_field {
+	uint32_t value;
+};
+
+template <uint8_t Digits>
+struct text_bin_field {
+	uint32_t value;
+};
+
+// Screen buffer of the selected LCD, cut off at the end of the row //
+struct text_lcd_sink {
+	uint8_t x;
+	uint8_t y;
+	void put(char character) { lcd_bufferPutChar(x++, y, character); }
+};
+
+// USART transmitter (must be initialized), waits for the data register per character //
+struct text_usart_sink {
+	USART_t& usart;
+	void put(char character) {
+		while (!(usart.STATUS & USART_DREIF_bm));
+		usart.TXDATAL = static_cast<uint8_t>(character);
+	}
+};
+
+// Character array, characters beyond size - 1 are dropped //
+struct text_buffer_sink {
+	char* position;
+	char* last;
+	void put(char character) {
+		if (position < last)
+			*position++ = character;
+	}
+};
+
+// FIELD FORMATS //
+/*
+*	Decimal number, right aligned.
+*	@param Width Field width (0: as many characters as needed); '#' if the number does not fit
+*	@param Fill Character left of the number
+*/
+template <uint8_t Width = 0, char Fill = ' '>
+inline text_dec_field<Width, Fill> text_dec(int32_t value) {
+	static_assert(Width <= 11, "text_dec: a 32-bit number has at most 11 characters");
+	return text_dec_field<Width, Fill>{value};
+}
+
+/*
+*	Hexadecimal number, upper case.
+*	@param Digits Number of digits with leading zeros (0: as many as needed)
+*/
+template <uint8_t Digits = 0>
+inline text_hex_field<Digits> text_hex(uint32_t value) {
+	static_assert(Digits <= 8, "text_hex: a 32-bit number has at most 8 hexadecimal digits");
+	return text_hex_field<Digits>{value};
+}
+
+/*
+*	Binary number.
+*	@param Digits Number of digits with leading zeros (0: as many as needed)
+*/
+template <uint8_t Digits = 0>
+inline text_bin_field<Digits> text_bin(uint32_t value) {
+	static_assert(Digits <= 32, "text_bin: a 32-bit number has at most 32 binary digits");
+	return text_bin_field<Digits>{value};
+}
+
+// CONVERSIONS (selected by the type of the argument) //
+template <typename Sink>
+inline void text_put_string(Sink& sink, const char* string) {
+	while (*string != '\0')
+		sink.put(*string++);
+}
+
+template <typename Sink>
+inline void text_put(Sink& sink, const char* string) { text_put_string(sink, string); }
+
+template <typename Sink>
+inline void text_put(Sink& sink, char character) { sink.put(character); }
+
+template <typename Sink>
+inline void text_put_signed(Sink& sink, int32_t value) {
+	char digits[12];
+	int_format_signed(digits, value);
+	text_put_string(sink, digits);
+}
+
+template <typename Sink>
+inline void text_put_unsigned(Sink& sink, uint32_t value) {
+	char digits[11];
+	int_format_unsigned(digits, value);
+	text_put_string(sink, digits);
+}
+
+// All integer types are printed in decimal (values are limited to 32 bits) //
+template <typename Sink> inline void text_put(Sink& sink, signed char value) { text_put_signed(sink, value); }
+template <typename Sink> inline void text_put(Sink& sink, unsigned char value) { text_put_unsigned(sink, value); }
+template <typename Sink> inline void text_put(Sink& sink, short value) { text_put_signed(sink, value); }
+template <typename Sink> inline void text_put(Sink& sink, unsigned short value) { text_put_unsigned(sink, value); }
+template <typename Sink> inline void text_put(Sink& sink, int value) { text_put_signed(sink, static_cast<int32_t>(value)); }
+template <typename Sink> inline void text_put(Sink& sink, unsigned int value) { text_put_unsigned(sink, static_cast<uint32_t>(value)); }
+template <typename Sink> inline void text_put(Sink& sink, long value) { text_put_signed(sink, static_cast<int32_t>(value)); }
+template <typename Sink> inline void text_put(Sink& sink, unsigned long value) { text_put_unsigned(sink, static_cast<uint32_t>(value)); }
+
+template <typename Sink, uint8_t Width, char Fill>
+inline void text_put(Sink& sink, const text_dec_field<Width, Fill>& field) {
+	char digits[12];
+	if (Width == 0)
+		int_format_signed(digits, field.value);
+	else
+		int_format_right(digits, field.value, Width, Fill);
+	text_put_string(sink, digits);
+}
+
+template <typename Sink, uint8_t Digits>
+inline void text_put(Sink& sink, const text_hex_field<Digits>& field) {
+	char digits[9];
+	int_format_hex(digits, field.value, Digits);
+	text_put_string(sink, digits);
+}
+
+template <typename Sink, uint8_t Digits>
+inline void text_put(Sink& sink, const text_bin_field<Digits>& field) {
+	char digits[33];
+	int_format_binary(digits, field.value, Digits);
+	text_put_string(sink, digits);
+}
+
+// OUTPUT //
+template <typename Sink>
+inline void text_write(Sink&) {}
+
+/*
+*	Writes all arguments to a sink, one conversion per argument.
+*
+*	@param sink Destination (type with put(char))
+*	@param first, rest Strings, characters, integers or fields (text_dec(), text_hex(), text_bin())
+*	@return None
+*/
+template <typename Sink, typename First, typename... Rest>
+inline void text_write(Sink& sink, const First& first, const Rest&... rest) {
+	text_put(sink, first);
+	text_write(sink, rest...);
+}
+
+/*
+*	Writes into the screen buffer of the selected LCD (sent with lcd_flush()).
+*
+*	@param x Column of the first character (cut off at the end of the row)
+*	@param y Row
+*	@return None
+*/
+template <typename... Args>
+inline void text_lcd(uint8_t x, uint8_t y, const Args&... args) {
+	text_lcd_sink sink = {x, y};
+	text_write(sink, args...);
+}
+
+/*
+*	Sends to a USART (blocking, the transmitter must be enabled).
+*
+*	@param usart e.g. USART3
+*	@return None
+*/
+template <typename... Args>
+inline void text_usart(USART_t& usart, const Args&... args) {
+	text_usart_sink sink = {usart};
+	text_write(sink, args...);
+}
+
+/*
+*	Writes into a character array.
+*
+*	@param buf Destination
+*	@param size Size of buf (the text is cut off at size - 1 characters, 0: nothing is written)
+*	@return uint8_t Number of characters (without '\0')
+*/
+template <typename... Args>
+inline uint8_t text_buffer(char* buf, uint8_t size, const Args&... args) {
+	if (size == 0)
+		return 0;
+
+	text_buffer_sink sink = {buf, buf + size - 1};
+	text_write(sink, args...);
+	*sink.position = '\0';
+	return static_cast<uint8_t>(sink.position - buf);
+}
+
+#endif /* TEXT_FORMAT_H_ */